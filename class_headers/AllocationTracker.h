@@ -0,0 +1,83 @@
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// which part of the frame an allocation belongs to, set by AllocationScope
+enum class AllocationTag : std::uint8_t {
+    UNTAGGED,
+    INPUT,
+    SIMULATION,
+    SPAWNING,
+    COLLISION,
+    EVENTS,
+    RENDER_BUILD, // filling the render snapshot
+    RENDERING, // SFML draw calls and display
+    UI, // menu and overlay text
+    COUNT
+};
+
+struct AllocationStats {
+    std::uint64_t allocations{0};
+    std::uint64_t bytes{0};
+    std::uint64_t violations{0}; // allocations made inside a scope declared allocation-free
+};
+
+using AllocationTotals = std::array<AllocationStats, static_cast<std::size_t>(AllocationTag::COUNT)>;
+
+// heap allocation counters fed by the replaced global operator new/delete (AllocationTracker.cpp), which are only
+// compiled in with the TRACK_ALLOCATIONS CMake option; without it every count stays 0.
+// The global counts are always on; per-tag counts and violations only while enabled.
+class AllocationTracker {
+public:
+    static bool isCompiledIn(); // built with TRACK_ALLOCATIONS
+    static std::uint64_t getAllocationCount(); // operator new calls since start
+    static std::uint64_t getAllocatedBytes(); // bytes requested since start, frees are not subtracted
+    static std::uint64_t getFreeCount();
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    static AllocationTotals getTotals(); // per tag, since tracking was first enabled
+    static const char* tagName(AllocationTag tag);
+};
+
+// tags every allocation on this thread until it goes out of scope; nests, the innermost scope wins
+class AllocationScope {
+    AllocationTag previousTag;
+    bool previousAllocationFree;
+
+public:
+    explicit AllocationScope(AllocationTag tag, bool allocationFree = false);
+    ~AllocationScope();
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    static AllocationTag currentTag(); // JobSystem hands these to its workers
+    static bool currentIsAllocationFree();
+};
+
+// per-frame deltas of the tracker: worst frame per tag and a line for every frame that broke an allocation-free scope
+class AllocationFrameLog {
+    AllocationTotals frameStart{};
+    AllocationTotals sum{};
+    std::array<std::uint64_t, static_cast<std::size_t>(AllocationTag::COUNT)> peakPerFrame{};
+    std::uint64_t frames{0};
+    std::uint64_t framesWithViolations{0};
+    std::uint64_t warmupFrames;
+    std::uint64_t warmupLeft;
+    std::size_t printedViolations{0};
+    static constexpr std::size_t maxPrintedViolations{20}; // the first ones point at the culprit, the rest is noise
+
+public:
+    explicit AllocationFrameLog(std::uint64_t warmupFrames = 0); // frames ignored while caches and pools fill up
+
+    void restartWarmup(); // a new level or mode starts, its first frames are expected to allocate
+    void beginFrame();
+    void endFrame(std::uint64_t frameNumber); // prints violations of this frame
+    void printSummary() const;
+    std::uint64_t getFramesWithViolations() const;
+};
+
+#endif //ALLOCATIONTRACKER_H
@@ -2,8 +2,11 @@
 #define BERSERKORC_H
 
 #include <SFML/Graphics.hpp>
-#include <random>
 #include "Entity.h"
+#include "GameRng.h"
+#include "NavGraph.h"
+#include <cstddef>
+#include <cstdint>
 
 class BerserkOrc : public Entity {
     enum class State { IDLE, WALKING }; // state enumeration
@@ -11,31 +14,61 @@ class BerserkOrc : public Entity {
 
     const float patrolRange{150.f}; // range of linear movement
     sf::Vector2f originPoint; // origin spawn point
+    float patrolLeft{}; // patrol limits, kept on the span the orc stands on after a chase
+    float patrolRight{};
     const float speed{2.f}; // movement speed
     bool isMovingRight{true}; // direction flag
 
-    sf::Clock stateTimer; // state timer
+    SimClock stateTimer; // state timer
     float currentStateDuration{0.f};
-    std::mt19937 rng;
+    GameRng rng;
 
     sf::RectangleShape hitboxShape;
     sf::FloatRect customHitbox;
     bool markedForRemoval{false}; // trigger flag for deletion
 
+    // pursuit, ordered by World's navigation pass
+    bool chasing{false};
+    bool hasLink{false}; // walking to chaseLink's takeoff, otherwise to chaseTargetX
+    NavLink chaseLink{};
+    float chaseTargetX{0.f};
+    float spanLeft{0.f}; // span the orc walks on while chasing
+    float spanRight{0.f};
+    bool airborne{false};
+    float airTicks{0.f}; // ticks spent on chaseLink's arc
+    std::int32_t replanCountdown{-1}; // -1 until the first plan staggers it
+
     void chooseNextState();
+    void moveAlongChase(); // one tick of walking or flying, no decisions
+    float feetOffset() const; // sprite Y to the bottom of the hitbox
 
 public:
+    static constexpr float chaseSpeed{3.f}; // px per tick on the ground, the arcs keep the player's air speed
+    static constexpr float navHalfWidth{38.4f}; // half the hitbox width at scale 2, landings keep this clear of edges
+
     BerserkOrc(sf::RenderWindow* win, const sf::Vector2f& startPos);
 
     // override base class functions
-    void actions() override;
     void update() override;
-    void draw() override;
+    void stepMovement() override;
+    void draw(sf::RenderTarget& target) override;
+    void appendRenderItems(RenderSnapshot& out) const override;
     void takeDamage() override;
 
     sf::FloatRect getCollisionBounds() const;
     void markForRemoval();
     bool isMarkedForRemoval() const;
+
+    // navigation orders; spanLeft/spanRight bound the walk on the current span
+    bool dueForReplan(std::size_t slot, int interval); // staggered by slot, never while in the air
+    void chaseTo(float targetX, float left, float right); // same span as the target
+    void chaseVia(const NavLink& link, float left, float right); // walk to the takeoff, then fly the arc
+    void stopChasing(float left, float right); // back to patrolling, inside the span
+    bool isChasing() const;
+    bool isAirborne() const; // on a jump or drop link, its trajectory does not depend on the platforms
+    sf::Vector2f getFeet() const;
+    void saveState(SnapshotWriter& writer) const override;
+    void loadState(SnapshotReader& reader) override;
     ~BerserkOrc() override = default;
 };
 
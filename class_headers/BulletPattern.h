@@ -0,0 +1,111 @@
+#ifndef BULLETPATTERN_H
+#define BULLETPATTERN_H
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "SpawnCommandBuffer.h"
+
+enum class PatternShape : std::uint32_t { // 4 bytes so BulletPattern has no padding, snapshots get hashed
+    RING,      // bulletsPerVolley evenly spaced around the emitter
+    SPIRAL,    // `arms` evenly spaced bullets, rotated by spinPerVolley every volley
+    AIMED_FAN, // bulletsPerVolley spread over spreadRadians around the aim angle
+    WAVE       // aimed fan whose centre sweeps by spreadRadians like a sine wave
+};
+
+// plain data, patterns can be constexpr presets or loaded from level/scenario files
+struct BulletPattern {
+    PatternShape shape{PatternShape::RING};
+    int bulletsPerVolley{12};
+    float volleyInterval{1.f}; // seconds between volleys, several volleys fire in one tick if it is shorter
+    float speed{3.f};
+    float spawnRadius{30.f}; // distance from the emitter centre
+    float spreadRadians{0.f};
+    float spinPerVolley{0.f}; // radians added to the phase every volley
+    int arms{1};
+};
+
+// sin/cos for a fixed number of angles, patterns never call std::sin/std::cos per bullet
+class DirectionTable {
+public:
+    static constexpr std::size_t resolution{4096}; // power of two so wrapping is a mask
+
+private:
+    std::array<sf::Vector2f, resolution> directions;
+    DirectionTable();
+
+public:
+    static const DirectionTable& getInstance();
+    const sf::Vector2f& at(float angleRadians) const; // nearest entry, any angle
+};
+
+// volley timing and phase for one pattern, writes SpawnCommands into a sink
+class PatternEmitter {
+    BulletPattern pattern;
+    float volleyTimer{0.f};
+    float phase{0.f};
+    std::uint32_t volleysFired{0};
+
+public:
+    explicit PatternEmitter(const BulletPattern& pattern = {});
+
+    void setPattern(const BulletPattern& newPattern); // also resets timing
+    const BulletPattern& getPattern() const;
+    void reset();
+
+    // fires every volley that became due during dt, returns how many bullets were written
+    template <typename Sink>
+    std::size_t update(float dt, const sf::Vector2f& origin, float aimAngle, Sink&& sink) {
+        if (pattern.volleyInterval <= 0.f) return 0;
+        std::size_t written = 0;
+        volleyTimer += dt;
+        while (volleyTimer >= pattern.volleyInterval) {
+            volleyTimer -= pattern.volleyInterval;
+            written += fireVolley(origin, aimAngle, sink);
+        }
+        return written;
+    }
+
+    // one volley right now, independent of the timer
+    template <typename Sink>
+    std::size_t fireVolley(const sf::Vector2f& origin, float aimAngle, Sink&& sink) {
+        const DirectionTable& table = DirectionTable::getInstance();
+        const int count = bulletCount();
+        const float first = firstAngle(aimAngle);
+        const float step = angleStep();
+        for (int i = 0; i < count; ++i) {
+            const sf::Vector2f& dir = table.at(first + step * static_cast<float>(i));
+            sink(SpawnCommand{SpawnKind::MAGIC_PROJECTILE,
+                              {origin.x + dir.x * pattern.spawnRadius, origin.y + dir.y * pattern.spawnRadius},
+                              dir, pattern.speed});
+        }
+        phase += pattern.spinPerVolley;
+        ++volleysFired;
+        return static_cast<std::size_t>(count);
+    }
+
+    int bulletCount() const; // bullets in one volley
+    float bulletsPerSecond() const;
+
+private:
+    float firstAngle(float aimAngle) const;
+    float angleStep() const;
+};
+
+// presets used by MageOrc and by the stress scenarios
+namespace BulletPatterns {
+    inline constexpr float fullTurn{6.28318530718f};
+
+    inline constexpr BulletPattern barrageRing{PatternShape::RING, 12, 1.f, 3.f, 30.f, 0.f, 0.f, 1};
+    inline constexpr BulletPattern flurryShot{PatternShape::AIMED_FAN, 1, 0.3f, 6.f, 0.f, 0.f, 0.f, 1};
+    inline constexpr BulletPattern spiral{PatternShape::SPIRAL, 0, 0.05f, 4.f, 30.f, 0.f, 0.35f, 4};
+    inline constexpr BulletPattern wave{PatternShape::WAVE, 5, 0.15f, 5.f, 30.f, 0.9f, 0.45f, 1};
+    // bullet-hell stress load, 16 arms every 1/60 s = 960 bullets per second
+    inline constexpr BulletPattern storm{PatternShape::SPIRAL, 0, 1.f / 60.f, 5.f, 30.f, 0.f, 0.13f, 16};
+
+    const BulletPattern* findPreset(std::string_view name); // "barrage_ring", "storm", ...; nullptr if unknown
+}
+
+#endif //BULLETPATTERN_H
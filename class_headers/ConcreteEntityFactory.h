@@ -20,8 +20,8 @@ public:
     std::unique_ptr<Entity> makeMagicProjectile(sf::RenderWindow* win, float x, float y, float dx, float dy, float speed) override;
 
     template <typename T, typename... Args>
-    static std::unique_ptr<T> create(Args&&... args) {
-        return std::make_unique<T>(std::forward<Args>(args)...);
+    static std::unique_ptr<T> create(std::pmr::memory_resource* resource, Args&&... args) { // Entity::operator new
+        return std::unique_ptr<T>(new (resource) T(std::forward<Args>(args)...));
     }
 };
 
@@ -4,6 +4,15 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <map>
+#include <cstddef>
+#include <memory_resource>
+#include "HandleTable.h"
+#include "SpawnCommandBuffer.h"
+#include "SimClock.h"
+#include "Snapshot.h"
+#include "SimulationLod.h"
+
+class RenderSnapshot;
 
 class Entity {
 protected:
@@ -12,39 +21,58 @@ protected:
     int frameWidth{0}, frameHeight{0}; // sprite measures
     int healthPoints{1}; // default hp
     sf::RenderWindow* window; // pointer to window
-    std::map<std::string, sf::Texture> animationTextures;
+    std::map<std::string, const sf::Texture*> animationTextures; // shared textures owned by TextureCache
     std::string currentAnimationName{"none"};
     sf::IntRect currentFrameRect;
-    sf::Clock animationClock;
+    SimClock animationClock;
     float currentAnimationInterval{0.1f};
     int currentNumFrames{0};
     int currentFrameIndex{0};
     float currentScaleX{1.f};
     float currentScaleY{1.f};
+    EntityHandle handle; // set by World when the entity is registered
+    SpawnCommandBuffer* spawnBuffer{nullptr}; // where spawn requests go during update
+    SimulationLodState lodState; // written by World's scheduler
 
     // load a specific animation for an entity
     bool loadAnimationTexture(const std::string& animationName, const std::string& texturePath);
+    void emitSpawn(const SpawnCommand& command) const; // queue a spawn, World creates it after the update pass
 
 public:
     // constructor takes a pointer to the render window
     explicit Entity(sf::RenderWindow* win);
 
     // pure virtual functions
-    virtual void draw() = 0; // draws the entity to the window
-    virtual void actions() = 0; // handles entity-specific actions
+    virtual void draw(sf::RenderTarget& target) = 0; // draws the entity right away, to the window or an off-screen texture
     virtual void takeDamage() = 0; // handles damage taken by the entity
 
     // virtual functions
     virtual void update(); // update the entity state
     virtual void setAnimation(const std::string& animationName, int numFrames, float interval); // set animation
     virtual void setScale(float scaleX, float scaleY); // set scale of entity sprite
+    virtual void saveState(SnapshotWriter& writer) const; // sprite, movement, health and animation
+    virtual void loadState(SnapshotReader& reader);
+    virtual void appendRenderItems(RenderSnapshot& out) const; // what draw() would draw, as plain data
+    virtual void stepMovement(); // between AI updates of a distant entity: keep moving, no decisions, timers or frames
+    bool onTextureReloaded(const sf::Texture& texture); // re-fits the frame when the sprite shows texture; false otherwise
 
     // public getters/setters
     int getHealthPoints() const;
     sf::FloatRect getVisualBounds() const; // returns global bounding box of sprite
     sf::Vector2f getPosition() const; // returns current position of sprite
+    sf::Vector2f getVelocity() const; // movement per tick
     void setPosition(float x, float y); // set position of sprite using x, y coordinates.
     void setPosition(const sf::Vector2f& pos); // set position of sprite using 2d vector
+    EntityHandle getHandle() const;
+    void setHandle(EntityHandle newHandle);
+    void setSpawnBuffer(SpawnCommandBuffer* buffer);
+    SimulationLodState& getLodState();
+
+    // every entity remembers where its memory came from, so a plain delete (unique_ptr) returns it there
+    static void* operator new(std::size_t size); // global heap
+    static void* operator new(std::size_t size, std::pmr::memory_resource* resource); // nullptr means global heap
+    static void operator delete(void* pointer);
+    static void operator delete(void* pointer, std::pmr::memory_resource* resource); // constructor threw
 
     // virtual destructor
     virtual ~Entity() = default; // deleting derived objects via base pointers
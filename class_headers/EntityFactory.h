@@ -2,14 +2,19 @@
 #define ENTITYFACTORY_H
 
 #include <memory>
+#include <memory_resource>
 #include "SFML/Graphics.hpp"
 
 class Entity;
 
 
 class EntityFactory {
+protected:
+    std::pmr::memory_resource* memoryResource{nullptr}; // where created entities live, nullptr = global heap
+
 public:
     virtual ~EntityFactory() = default;
+    void setMemoryResource(std::pmr::memory_resource* resource) { memoryResource = resource; } // World hands in its arena
     // specific entity-factories
     virtual std::unique_ptr<Entity> makeBerserkOrc(sf::RenderWindow* win, const sf::Vector2f& pos) = 0;
     virtual std::unique_ptr<Entity> makeMageOrc(sf::RenderWindow* win, const sf::Vector2f& pos) = 0;
@@ -0,0 +1,40 @@
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "GameEvents.h"
+#include "Observer.h"
+
+// per-tick event queue, gameplay code only appends and subscribers are called in one batch
+class EventBus {
+    struct Subscription {
+        Observer* observer;
+        std::uint32_t typeMask; // one bit per GameEvent
+        bool mergeDuplicates; // same (type, entity) delivered once per batch
+    };
+
+    std::vector<GameEventData> pending; // filled during the tick
+    std::vector<GameEventData> delivering; // batch currently being dispatched
+    std::vector<Subscription> subscriptions;
+    std::vector<GameEventData> mergeScratch; // events already delivered to a merging subscriber
+
+public:
+    static constexpr std::uint32_t allEvents{0xFFFFFFFFu};
+    static constexpr std::uint32_t maskOf(GameEvent event) { return 1u << static_cast<std::uint32_t>(event); }
+
+    explicit EventBus(std::size_t expectedEventsPerTick = 64);
+
+    void subscribe(Observer* observer, std::uint32_t typeMask = allEvents, bool mergeDuplicates = false);
+    void unsubscribe(Observer* observer);
+
+    void post(const GameEventData& event); // queue for the next dispatch
+    void post(GameEvent type, int entityId = -1, const sf::Vector2f& position = {0.f, 0.f});
+    void dispatch(); // deliver everything queued so far, events posted meanwhile wait for the next call
+    std::size_t pendingCount() const;
+    void discardPending(); // drop queued events, e.g. the ones raised while re-simulating rolled-back ticks
+};
+
+#endif //EVENTBUS_H
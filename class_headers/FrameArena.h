@@ -0,0 +1,53 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+struct FrameArenaStats {
+    std::uint64_t frames{0};
+    std::size_t capacityBytes{0};
+    std::size_t peakBytes{0}; // most bytes handed out in a single frame
+    std::uint64_t overflowFrames{0}; // frames that spilled past the buffer onto the heap
+};
+
+// scratch memory that lives for one frame: bump allocation out of a preallocated buffer, nothing is freed
+// until reset() at the top of the next loop iteration. Not thread-safe, only the thread running the loop uses it.
+class FrameArena : public std::pmr::memory_resource {
+    // heap behind the buffer, counts how often the buffer was not enough
+    class OverflowResource : public std::pmr::memory_resource {
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    public:
+        std::uint64_t allocations{0};
+    };
+
+    std::unique_ptr<std::byte[]> buffer;
+    OverflowResource overflow;
+    std::pmr::monotonic_buffer_resource arena; // bump pointer over buffer, then over blocks from overflow
+    std::size_t frameBytes{0};
+    std::uint64_t overflowAtFrameStart{0};
+    FrameArenaStats stats;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {} // released in bulk by reset()
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    static constexpr std::size_t defaultCapacity{256 * 1024};
+
+    explicit FrameArena(std::size_t capacityBytes = defaultCapacity);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void reset(); // everything allocated since the last reset is gone, containers using it must be dead by now
+    std::size_t bytesThisFrame() const;
+    const FrameArenaStats& getStats() const;
+    void printSummary() const;
+};
+
+#endif // FRAMEARENA_H
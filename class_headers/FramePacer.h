@@ -0,0 +1,55 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+enum class PacingMode {
+    VSYNC,       // display() blocks on the monitor refresh, the pacer only measures
+    TARGET_RATE, // sleep most of the frame, spin the last stretch for a precise deadline
+    UNLIMITED    // no waiting, benchmarks
+};
+
+struct PacingStats {
+    std::size_t samples{0};
+    double meanIntervalMs{0.0};
+    double stdDevMs{0.0}; // present-to-present jitter
+    double p99DeviationMs{0.0}; // from the mean interval
+    double maxIntervalMs{0.0};
+    double spinMarginMs{0.0}; // current sleep safety margin
+};
+
+// paces the main loop on a steady clock instead of setFramerateLimit's single coarse sleep.
+// call waitForNextFrame() right before polling input, presented() right after window.display()
+class FramePacer {
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::size_t historySize{600}; // intervals kept for the stats, ~6s at 90 Hz
+    static constexpr Clock::duration minSpinMargin{std::chrono::microseconds(200)};
+    static constexpr Clock::duration maxSpinMargin{std::chrono::milliseconds(4)};
+
+    PacingMode mode;
+    Clock::duration framePeriod;
+    Clock::duration spinMargin{std::chrono::milliseconds(1)}; // adapts to how late the OS wakes us up
+    Clock::time_point nextDeadline;
+    Clock::time_point lastFrameStart;
+    Clock::time_point lastPresent;
+    bool presentedOnce{false};
+    std::vector<double> intervalsMs; // ring
+    std::size_t nextInterval{0};
+
+    void sleepThenSpin(Clock::time_point deadline);
+
+public:
+    FramePacer(sf::RenderWindow& window, PacingMode mode, float targetHz = 90.f); // takes over the window's vsync/limit settings
+
+    float waitForNextFrame(); // blocks until the frame may start, returns seconds since the previous frame start
+    void presented(); // timestamps the present for the jitter stats
+    void restartDelta(); // the next dt excludes time spent since (loading, pause)
+
+    PacingStats getStats() const;
+    PacingMode getMode() const;
+};
+
+#endif //FRAMEPACER_H
@@ -0,0 +1,57 @@
+#ifndef FRAMERENDERER_H
+#define FRAMERENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "RenderSnapshot.h"
+#include "RenderStats.h"
+#include "TripleBuffer.h"
+
+class FramePacer;
+
+// draws RenderSnapshots to the window, either inline or on a dedicated thread that owns the GL context,
+// so a slow display() no longer delays the next update and simulating frame N+1 overlaps drawing frame N
+class FrameRenderer {
+    sf::RenderWindow& window;
+    FramePacer* pacer; // told about every present, may be null
+    bool threaded;
+    int renderCore; // -1 = not pinned
+
+    TripleBuffer<RenderSnapshot> frames;
+    std::thread renderThread;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<std::uint64_t> wakeSignal{0}; // bumped by submit() and stop(), the render thread waits on it
+    std::atomic<std::uint64_t> publishedFrames{0};
+    std::atomic<std::uint64_t> renderedFrames{0};
+    std::mutex presentMutex; // held while a frame is drawn, see pauseRendering()
+    RenderStats frameStats; // scratch of the drawing thread
+    mutable std::mutex statsMutex; // guards the two below, written once per present
+    RenderStats lastFrameStats;
+    RenderStats totalStats; // over every rendered frame
+
+    void present(const RenderSnapshot& snapshot);
+    void renderLoop();
+
+public:
+    FrameRenderer(sf::RenderWindow& window, FramePacer* pacer, bool threaded, int renderCore = -1);
+    ~FrameRenderer();
+    FrameRenderer(const FrameRenderer&) = delete;
+    FrameRenderer& operator=(const FrameRenderer&) = delete;
+
+    RenderSnapshot& beginFrame(); // cleared snapshot for the simulation to fill
+    void submit(); // threaded: hand over and return at once; inline: draw and display now
+    void stop(); // joins the render thread and gives the GL context back to the calling thread
+    // no frame is drawn while the lock is held, so resources a queued frame points to can be replaced (hot reload)
+    [[nodiscard]] std::unique_lock<std::mutex> pauseRendering();
+
+    bool isThreaded() const;
+    std::uint64_t getPublishedFrames() const;
+    std::uint64_t getRenderedFrames() const; // fewer than published when the renderer fell behind
+    RenderStats getLastFrameStats() const; // counters of the most recent present, safe from any thread
+    RenderStats getTotalStats() const; // divide by getRenderedFrames() for the per-frame mean
+};
+
+#endif //FRAMERENDERER_H
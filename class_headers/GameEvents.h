@@ -1,13 +1,26 @@
 #ifndef GAMEEVENTS_H
 #define GAMEEVENTS_H
 
-enum class GameEvent {
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+enum class GameEvent : std::uint8_t {
   PLAYER_JUMPED,         // jump sound
   PLAYER_TOOK_DAMAGE,    // hurt sound
   BUTTON_CLICKED,        // button click
   GAME_STARTED,          // intro sound
   MENU_ENTERED,          // menu music
-  GAMEPLAY_STARTED       // stop menu music
+  GAMEPLAY_STARTED,      // stop menu music
+  PLAYER_FIRED,          // muzzle flash
+  PROJECTILE_HIT,        // sparks where a player bullet hit an enemy
+  ENEMY_DIED             // debris burst
+};
+
+// small payload queued with every event
+struct GameEventData {
+    GameEvent type;
+    int entityId{-1}; // -1 when the event is not tied to an entity
+    sf::Vector2f position{0.f, 0.f}; // where it happened (world coordinates)
 };
 
-#endif //GAMEEVENTS_H
\ No newline at end of file
+#endif //GAMEEVENTS_H
@@ -0,0 +1,45 @@
+#ifndef GAMERNG_H
+#define GAMERNG_H
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+// PCG32 (O'Neill), 16 bytes of state instead of mt19937's 2.5 KB so it is cheap to snapshot.
+// Satisfies UniformRandomBitGenerator, the std distributions work with it unchanged.
+class GameRng {
+    std::uint64_t state{0};
+    std::uint64_t increment{1};
+
+public:
+    using result_type = std::uint32_t;
+
+    explicit GameRng(std::uint64_t seed = 0x853c49e6748fea9bULL, std::uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        increment = (stream << 1u) | 1u;
+        (*this)();
+        state += seed;
+        (*this)();
+    }
+
+    result_type operator()() {
+        const std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        const auto xorShifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        const auto rotation = static_cast<std::uint32_t>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    // same inputs give the same seed on every machine, used so networked peers spawn identical enemies
+    static std::uint64_t seedFrom(float x, float y, double time) {
+        std::uint64_t z = (static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(x)) << 32u) ^
+                          std::bit_cast<std::uint32_t>(y) ^ std::bit_cast<std::uint64_t>(time);
+        z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ULL; // splitmix64 finaliser
+        z = (z ^ (z >> 27u)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31u);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+};
+
+#endif //GAMERNG_H
@@ -0,0 +1,46 @@
+#ifndef GOLDENFRAMES_H
+#define GOLDENFRAMES_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+class RenderSnapshot;
+
+struct ImageDiff {
+    bool sizeMismatch{false};
+    std::size_t differingPixels{0}; // any channel off by more than the tolerance
+    int maxChannelDelta{0};
+};
+
+// renders fixed scenes off-screen and compares them with reference PNGs, so a change to the draw path
+// (batching, atlases, ...) can be checked for pixel equivalence; references come from the same GL stack (Xvfb/Mesa)
+class GoldenFrames {
+    static constexpr unsigned int frameWidth{1600}, frameHeight{900};
+
+    struct Scene {
+        std::string name;
+        std::function<void(RenderSnapshot&)> build;
+    };
+
+    std::string directory;
+    bool update; // write the references instead of comparing
+    int channelTolerance;
+    double maxDifferingFraction;
+
+    static void writeDiffImage(const sf::Image& actual, const sf::Image& expected, int channelTolerance, const std::string& path);
+
+public:
+    GoldenFrames(std::string directory, bool update, int channelTolerance = 2, double maxDifferingFraction = 0.0005);
+
+    static ImageDiff compare(const sf::Image& actual, const sf::Image& expected, int channelTolerance);
+
+    int run() const; // scenes that failed (mismatch or missing reference); writes <scene>.actual.png and <scene>.diff.png next to it
+
+    // `--golden [<dir>] [--update-golden] [--tolerance <n>]`, exit code 4 when a scene does not match
+    static int runFromCommandLine(const std::vector<std::string>& args);
+};
+
+#endif //GOLDENFRAMES_H
@@ -0,0 +1,84 @@
+#ifndef HANDLETABLE_H
+#define HANDLETABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 32-bit slot index plus generation, stays safe to hold after the entity is gone
+struct EntityHandle {
+    static constexpr std::uint32_t invalidIndex{0xFFFFFFFFu};
+
+    std::uint32_t index{invalidIndex};
+    std::uint32_t generation{0};
+
+    bool isNull() const { return index == invalidIndex; }
+    friend bool operator==(const EntityHandle&, const EntityHandle&) = default;
+};
+
+// maps handles to objects, freed slots are reused with a bumped generation so old handles go stale
+template <typename T>
+class HandleTable {
+    struct Slot {
+        T* object{nullptr};
+        std::uint32_t generation{1}; // 0 is never handed out, a default handle is always stale
+        std::uint32_t nextFree{EntityHandle::invalidIndex};
+    };
+
+    std::vector<Slot> slots;
+    std::uint32_t freeHead{EntityHandle::invalidIndex};
+    std::size_t liveCount{0};
+
+public:
+    EntityHandle insert(T* object) {
+        std::uint32_t index;
+        if (freeHead != EntityHandle::invalidIndex) {
+            index = freeHead;
+            freeHead = slots[index].nextFree;
+        } else {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        slots[index].object = object;
+        slots[index].nextFree = EntityHandle::invalidIndex;
+        ++liveCount;
+        return {index, slots[index].generation};
+    }
+
+    void remove(EntityHandle handle) {
+        if (!isValid(handle)) return;
+        Slot& slot = slots[handle.index];
+        slot.object = nullptr;
+        ++slot.generation;
+        if (slot.generation == 0) slot.generation = 1; // skip 0 on wrap-around
+        slot.nextFree = freeHead;
+        freeHead = handle.index;
+        --liveCount;
+    }
+
+    bool isValid(EntityHandle handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+               slots[handle.index].object != nullptr;
+    }
+
+    T* get(EntityHandle handle) const { return isValid(handle) ? slots[handle.index].object : nullptr; }
+
+    std::size_t size() const { return liveCount; }
+
+    void clear() { // invalidates every handle, keeps the slots for reuse
+        freeHead = EntityHandle::invalidIndex;
+        for (std::uint32_t i = static_cast<std::uint32_t>(slots.size()); i-- > 0;) {
+            Slot& slot = slots[i];
+            if (slot.object) {
+                slot.object = nullptr;
+                ++slot.generation;
+                if (slot.generation == 0) slot.generation = 1;
+            }
+            slot.nextFree = freeHead;
+            freeHead = i;
+        }
+        liveCount = 0;
+    }
+};
+
+#endif //HANDLETABLE_H
@@ -0,0 +1,81 @@
+#ifndef HOTRELOADER_H
+#define HOTRELOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LevelSpec.h"
+
+class World;
+class SoundManager;
+
+// one changed file, decoded on the watcher thread and waiting for the next frame boundary
+struct DecodedAsset {
+    enum class Kind : std::uint8_t { TEXTURE, SOUND, LEVEL };
+
+    Kind kind{Kind::TEXTURE};
+    std::string path; // normalised, relative to the working directory
+    sf::Image image; // TEXTURE
+    std::vector<sf::Int16> samples; // SOUND, interleaved
+    unsigned int channelCount{0}, sampleRate{0};
+    LevelSpec level; // LEVEL
+    double decodeMs{0.0};
+};
+
+struct HotReloadStats {
+    std::size_t reloaded{0}; // assets swapped in
+    std::size_t failed{0}; // changes that did not decode (half-written file, bad level), the old asset stays
+    std::size_t patchedEntities{0};
+};
+
+// watches asset directories and a level file with inotify; a changed texture, sound or level is decoded on its own
+// thread and swapped in by applyPending() between two frames, without a restart or a new World
+class HotReloader {
+    static constexpr auto settleTime = std::chrono::milliseconds(80); // editors write a file in several bursts
+
+    std::vector<std::string> roots;
+    std::string levelPath; // normalised, empty when levels are not reloaded
+    int inotifyFd{-1};
+    std::map<int, std::string> watchedDirectories; // inotify watch descriptor -> directory
+    std::map<std::string, std::chrono::steady_clock::time_point> changed; // watcher thread only, path -> last event
+
+    std::thread watcherThread;
+    std::atomic<bool> stopRequested{false};
+    mutable std::mutex readyMutex; // guards ready and failedDecodes
+    std::vector<DecodedAsset> ready;
+    std::size_t failedDecodes{0};
+    std::atomic<std::size_t> readyCount{0}; // lets the frame loop skip the lock when nothing changed
+    HotReloadStats stats;
+
+    void addWatch(const std::string& directory);
+    void readEvents();
+    void decodeSettled();
+    bool decode(const std::string& path, DecodedAsset& out) const; // false for files nobody loads (by extension)
+    void watchLoop();
+
+public:
+    static bool supported(); // inotify is Linux only
+
+    // throws ConfigurationError when unsupported or a directory cannot be watched
+    explicit HotReloader(std::vector<std::string> roots, const std::string& levelPath = {});
+    ~HotReloader(); // stops the watcher thread
+    HotReloader(const HotReloader&) = delete;
+    HotReloader& operator=(const HotReloader&) = delete;
+
+    bool hasPending() const;
+    // main thread, between frames and with rendering paused: swaps decoded assets into TextureCache, the world and the
+    // sound buffers, patches entities showing a reloaded texture; a new level replaces the platforms of world and level.
+    // Returns true when the world's platforms changed: they are not part of a snapshot, so every snapshot taken before
+    // (rewind history, quick-save) would restore entities into a layout they never ran in
+    bool applyPending(World* world, SoundManager* sounds, LevelSpec& level); // either may be null (not loaded yet)
+    const HotReloadStats& getStats() const;
+};
+
+#endif //HOTRELOADER_H
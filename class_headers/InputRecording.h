@@ -0,0 +1,39 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "PlayerInput.h"
+
+// player inputs of a session, one per fixed tick; stored as run-length encoded text so it can be checked in
+class InputRecording {
+    std::vector<PlayerInput> inputs;
+
+public:
+    static constexpr float tickSeconds{1.f / 60.f};
+
+    void push(const PlayerInput& input);
+    void clear();
+    std::size_t size() const; // ticks
+    PlayerInput at(std::size_t tick) const; // no buttons past the end
+
+    void saveToFile(const std::string& path) const; // throws ResourceLoadError
+    static InputRecording loadFromFile(const std::string& path); // throws ResourceLoadError/ConfigurationError
+};
+
+// samples live keyboard input at the recording tick rate, independent of the frame rate
+class InputRecorder {
+    InputRecording recording;
+    std::string path;
+    float accumulator{0.f};
+
+public:
+    explicit InputRecorder(std::string path);
+
+    void restart(); // new session, the previous one is discarded
+    void update(float dt, const PlayerInput& input); // appends one entry per elapsed tick
+    void save() const;
+};
+
+#endif //INPUTRECORDING_H
@@ -0,0 +1,42 @@
+#ifndef INPUTSNAPSHOT_H
+#define INPUTSNAPSHOT_H
+
+#include <SFML/Window.hpp>
+#include <array>
+#include <bitset>
+#include <chrono>
+
+// keyboard/mouse state built from the pollEvent stream once per tick, instead of querying the
+// window system per key (every sf::Keyboard::isKeyPressed is an X server round trip on Linux)
+class InputSnapshot {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    static constexpr std::size_t keyCount{sf::Keyboard::KeyCount};
+    static constexpr std::size_t buttonCount{sf::Mouse::ButtonCount};
+
+    std::bitset<keyCount> keysDown, keysPressed, keysReleased; // pressed/released are edges of the current tick
+    std::bitset<buttonCount> buttonsDown, buttonsPressed;
+    std::array<Clock::time_point, keyCount> keyPressTime{}; // when the press event was polled (SFML 2 events carry no timestamp)
+    sf::Vector2i mousePosition{-1, -1};
+
+    static bool validKey(sf::Keyboard::Key key);
+    void releaseAll(); // focus loss, the matching release events will never arrive
+
+public:
+    void beginTick(); // clears the edges, held keys stay down
+    void handleEvent(const sf::Event& event);
+
+    bool isDown(sf::Keyboard::Key key) const;
+    bool wasPressed(sf::Keyboard::Key key) const; // went down this tick
+    bool wasReleased(sf::Keyboard::Key key) const; // went up this tick
+    bool isActive(sf::Keyboard::Key key) const; // down, or tapped and released within this tick
+    Clock::time_point getPressTime(sf::Keyboard::Key key) const; // latest press, for sub-frame timing
+
+    bool isButtonDown(sf::Mouse::Button button) const;
+    bool wasButtonPressed(sf::Mouse::Button button) const;
+    sf::Vector2i getMousePosition() const; // window coordinates from the last mouse event
+};
+
+#endif //INPUTSNAPSHOT_H
@@ -0,0 +1,71 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AllocationTracker.h"
+
+// work-stealing thread pool for data-parallel passes over entities
+class JobSystem {
+public:
+    // body(chunkIndex, begin, end), chunk indices are stable so results can be merged in order
+    using RangeFunction = std::function<void(std::size_t, std::size_t, std::size_t)>;
+
+private:
+    struct Job {
+        const RangeFunction* body;
+        std::size_t chunkIndex;
+        std::size_t begin;
+        std::size_t end;
+        AllocationTag allocationTag; // the submitting thread's scope, applied on whichever thread runs the job
+        bool allocationFree;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs; // owner pops the back, thieves take from head; capacity is kept, no allocation per batch
+        std::size_t head{0};
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // queue 0 belongs to the calling thread
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::size_t submittedBatches{0}; // bumped on every parallelFor, wakes sleeping workers
+    bool stopping{false};
+
+    std::atomic<std::size_t> remainingJobs{0};
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+
+    static thread_local std::size_t workerIndex; // 0 on any non-worker thread
+
+    void workerLoop(std::size_t index);
+    bool popOwn(std::size_t index, Job& job);
+    bool steal(std::size_t thiefIndex, Job& job);
+    void runJob(const Job& job);
+
+public:
+    explicit JobSystem(std::size_t threadCount = 0); // 0 = size to the hardware
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // splits [0, count) into grain-sized chunks and blocks until all of them ran, rethrows the first job error
+    void parallelFor(std::size_t count, std::size_t grainSize, const RangeFunction& body);
+
+    std::size_t getThreadCount() const; // workers plus the calling thread
+    static std::size_t chunkCount(std::size_t count, std::size_t grainSize);
+    static std::size_t currentWorkerIndex();
+};
+
+#endif //JOBSYSTEM_H
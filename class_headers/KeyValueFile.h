@@ -0,0 +1,53 @@
+#ifndef KEYVALUEFILE_H
+#define KEYVALUEFILE_H
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "GameExceptions.h"
+
+// `key = value` text files (stress scenarios, replay budgets), '#' starts a comment
+namespace KeyValueFile {
+    inline std::string trim(const std::string& text) {
+        auto notSpace = [](unsigned char c) { return !std::isspace(c); };
+        auto first = std::ranges::find_if(text, notSpace);
+        auto last = std::find_if(text.rbegin(), text.rend(), notSpace).base();
+        return first < last ? std::string(first, last) : std::string{};
+    }
+
+    template <typename T>
+    T parseValue(const std::string& key, const std::string& value, const std::string& path, int lineNumber) {
+        std::istringstream stream(value);
+        T parsed{};
+        if (!(stream >> parsed) || !(stream >> std::ws).eof()) {
+            throw ConfigurationError("Invalid value '" + value + "' for '" + key + "' in " + path + ":" + std::to_string(lineNumber));
+        }
+        return parsed;
+    }
+
+    // calls onEntry(key, value, lineNumber) for every entry; `kind` names the file in load errors
+    template <typename Callback>
+    void forEachEntry(const std::string& path, const std::string& kind, Callback&& onEntry) {
+        std::ifstream file(path);
+        if (!file) {
+            throw ResourceLoadError(kind, path, "could not open file");
+        }
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty()) continue;
+
+            const std::size_t equals = line.find('=');
+            if (equals == std::string::npos) {
+                throw ConfigurationError("Expected 'key = value' in " + path + ":" + std::to_string(lineNumber));
+            }
+            onEntry(trim(line.substr(0, equals)), trim(line.substr(equals + 1)), lineNumber);
+        }
+    }
+}
+
+#endif //KEYVALUEFILE_H
@@ -0,0 +1,20 @@
+#ifndef LEVELSPEC_H
+#define LEVELSPEC_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// initial layout of a level, World::reset rebuilds the world from it
+struct LevelSpec {
+    std::vector<sf::FloatRect> platforms;
+    sf::Vector2f playerStart{200.f, 0.f};
+    std::vector<sf::Vector2f> berserkOrcs;
+    std::vector<sf::Vector2f> mageOrcs; // every mage targets the player
+
+    static LevelSpec defaultLevel(const sf::Vector2u& windowSize); // the original hand-placed level
+    // `platform = x y w h`, `player = x [y]`, `berserk_orc = x [y]`, `mage_orc = x y`; y defaults to the ground
+    static LevelSpec loadFromFile(const std::string& path); // throws ResourceLoadError / ConfigurationError
+};
+
+#endif //LEVELSPEC_H
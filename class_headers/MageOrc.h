@@ -3,19 +3,14 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <random>
+#include <optional>
 #include "Entity.h"
-
-// projectile data structure
-struct MagicProjectileSpawnInfo {
-    sf::Vector2f position; // projectile position
-    sf::Vector2f direction; // projectile direction
-    float speed;
-};
+#include "GameRng.h"
+#include "BulletPattern.h"
 
 class MageOrc : public Entity {
     // state enumeration
-    enum class State { IDLE, FLYING, BARRAGE_PREPARE, BARRAGE_FIRE, FLURRY, ARTILLERY};
+    enum class State { IDLE, FLYING, BARRAGE_PREPARE, BARRAGE_FIRE, FLURRY, SPIRAL, WAVE};
     State currentState{State::IDLE}; // current state initially idle
 
     // state variables
@@ -26,24 +21,18 @@ class MageOrc : public Entity {
     float currentCenterY;
 
     // state timers
-    sf::Clock stateTimer;
+    SimClock stateTimer;
     float currentStateDuration;
-    sf::Clock actionTimer;
+    SimClock actionTimer;
     float timeSinceLastAction;
-    std::mt19937 rng;
+    GameRng rng;
 
     // class constants
-    const int barrageCount{12};
-    const float barrageRadius{100.f};
-    const float barrageProjectileSpeed{3.f};
-    const float flurryShotInterval{0.3f};
-    const float flurryProjectileSpeed{6.f};
-    const float m_pi{3.14159};
     const float flurryAimVariance{0.45f};
-    sf::Vector2f* playerPositionPtr{nullptr};
-
-    // projectile vector
-    std::vector<MagicProjectileSpawnInfo> projectilesToSpawn;
+    const float flurryHorizontalOffset{40.f};
+    PatternEmitter patternEmitter; // pattern of the current attack state
+    EntityHandle targetHandle; // who to aim at, resolved by World every tick
+    std::optional<sf::Vector2f> targetPosition; // copy of the target's position, empty when it is gone
 
     // hitbox information
     sf::RectangleShape hitboxShape;
@@ -56,26 +45,32 @@ class MageOrc : public Entity {
     // private functions for state handling
     void chooseNextState();
     void updateSinusoidalMovement(float centerY, float amplitude, float frequency);
-    sf::Vector2f calculateVagueAimDirection();
+    float calculateAimAngle() const;
+    float calculateVagueAimAngle();
     void prepareBarrage();
     void fireBarrage();
     void fireFlurryShot(float dt);
+    void firePattern(float dt);
 
 public:
     MageOrc(sf::RenderWindow* win, const sf::Vector2f& startPos);
 
     // override base class functions
-    void actions() override;
     void update() override;
-    void draw() override;
+    void stepMovement() override;
+    void draw(sf::RenderTarget& target) override;
+    void appendRenderItems(RenderSnapshot& out) const override;
     void takeDamage() override;
 
     void updater(float dt);
     void markForRemoval();
     bool isMarkedForRemoval() const; // getter
-    std::vector<MagicProjectileSpawnInfo> getProjectilesToSpawn();
-    void updatePlayerPosition(sf::Vector2f* playerPos);
+    void setTarget(EntityHandle target);
+    EntityHandle getTarget() const;
+    void updateTargetPosition(const std::optional<sf::Vector2f>& position);
     sf::FloatRect getCollisionBounds() const;
+    void saveState(SnapshotWriter& writer) const override; // target handle is not saved, World re-targets on restore
+    void loadState(SnapshotReader& reader) override;
 };
 
 #endif //MAGEORC_H
\ No newline at end of file
@@ -13,14 +13,15 @@ public:
 
     // override base class functions
     void update () override;
-    void draw() override;
-    void actions() override;
+    void draw(sf::RenderTarget& target) override;
     void takeDamage() override;
 
     // specific member functions
     void markForRemoval();
     bool isMarkedForRemoval() const;
     void checkOffScreen();
+    void applyIntegratedPosition(float x, float y); // position from World's projectile arrays, advances animation
+    void reset(float x, float y, float dx, float dy, float projectileSpeed); // reuse a pooled bullet
 };
 
 #endif //MAGICPROJECTILE_H
\ No newline at end of file
@@ -4,9 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include "Subject.h"
 
+class RenderSnapshot;
+
 class Menu : public Subject {
     sf::RenderWindow* window;              // pointer to the main window
-    sf::Font font;                         // font used for text
+    const sf::Font& font;                  // font used for text, shared with the other overlays
     sf::Text title;                        // game title text
     sf::Text startButtonText;             // start button label
     sf::RectangleShape buttonBox;         // shape for the start button
@@ -19,15 +21,20 @@ class Menu : public Subject {
     bool isHovering{false};               // true if mouse on button
 
     static void centerOrigin(sf::Text& text); // center text origin
-    void loadBackground();                   // load background assets
+    void loadBackground(const sf::Image& image); // upload the background, decoded elsewhere
 
 public:
-    explicit Menu(sf::RenderWindow* win);   // constructor with window
+    static constexpr const char* backgroundPath{"assets/backgrounds/bg_menu.png"};
+
+    // font and background are loaded by the caller (in parallel at start-up), the font must outlive the menu
+    Menu(sf::RenderWindow* win, const sf::Font& font, const sf::Image& background);
 
-    void draw() const;                      // draw menu to window
+    void draw(sf::RenderTarget& target) const; // draw menu to the window or an off-screen texture
+    void appendRenderItems(RenderSnapshot& out) const; // same as draw, for the frame renderer
     void handleInput(const sf::Event& event); // handle user input
     void update(float dt);                  // update menu state
     bool isStartRequested() const;          // check start flag
+    void clearStartRequest();               // consumed, menu can be shown again
 };
 
 #endif // MENU_H
\ No newline at end of file
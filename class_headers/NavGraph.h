@@ -0,0 +1,88 @@
+#ifndef NAVGRAPH_H
+#define NAVGRAPH_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+class Platform;
+
+// what a walker can do in the air, in px and simulation ticks
+struct JumpPhysics {
+    float runSpeed{}; // px per tick, also the horizontal speed in the air
+    float jumpSpeed{}; // upwards launch speed, px per tick
+    float gravity{}; // px per tick^2
+
+    float maxJumpHeight() const; // apex of a standing jump
+    // ticks until a body launched with launchVy (screen space, negative is up) comes down at rise px above
+    // the launch point; nullopt when it never gets that high
+    std::optional<float> airTicks(float launchVy, float rise) const;
+};
+
+struct NavSpan { // walkable top surface: the ground or one platform
+    float left{};
+    float right{};
+    float y{}; // where feet stand
+};
+
+enum class NavLinkKind : std::int32_t { DROP, JUMP };
+
+struct NavLink { // one airborne move between spans; only 4-byte fields, walkers keep a copy in their snapshot
+    std::int32_t from{-1};
+    std::int32_t to{-1};
+    NavLinkKind kind{NavLinkKind::DROP};
+    float takeoffX{};
+    float landingX{};
+    float fromY{};
+    float toY{};
+    float launchVy{}; // 0 for a drop
+    float gravity{};
+    float airTicks{};
+    float cost{}; // px travelled plus a penalty for leaving the ground
+
+    sf::Vector2f feetAt(float tick) const; // point on the arc, clamped to the landing
+};
+
+struct NavGraphStats {
+    std::size_t spans{0};
+    std::size_t links{0};
+    std::size_t searches{0}; // A* runs
+    std::size_t cacheHits{0}; // queries answered from an earlier run
+};
+
+// built once per level from the platforms; queries are read-only apart from the path cache
+class NavGraph {
+    std::vector<NavSpan> spans; // 0 is the ground
+    std::vector<NavLink> links; // sorted by from, then to
+    std::vector<std::uint32_t> firstLink; // links leaving span s are [firstLink[s], firstLink[s + 1])
+    // per goal span, the first link from every start span; a column is allocated on the first query for its goal.
+    // every entry is a pure function of (start, goal), so cached and fresh answers agree and rollback stays deterministic
+    mutable std::vector<std::vector<std::int32_t>> nextLinkCache;
+    mutable NavGraphStats stats;
+
+    void addLinksFrom(std::int32_t from, const JumpPhysics& physics, float agentHalfWidth, float worldWidth);
+    std::int32_t search(std::int32_t start, std::int32_t goal, std::pmr::memory_resource* scratch) const; // A*
+
+public:
+    static constexpr std::int32_t sameSpan{-1};
+    static constexpr std::int32_t unreachable{-2};
+
+    // agentHalfWidth keeps landings clear of the edges
+    void build(std::span<const Platform> platforms, float groundY, float worldWidth, const JumpPhysics& physics, float agentHalfWidth);
+    void clear();
+
+    std::optional<std::int32_t> spanBelow(const sf::Vector2f& feet, float tolerance) const; // highest span under feet
+    // link to take from start towards goal, or sameSpan / unreachable; scratch backs the search on a cache miss
+    std::int32_t nextLink(std::int32_t start, std::int32_t goal, std::pmr::memory_resource* scratch) const;
+
+    const NavSpan& getSpan(std::int32_t index) const;
+    const NavLink& getLink(std::int32_t index) const;
+    std::size_t getSpanCount() const;
+    const NavGraphStats& getStats() const;
+};
+
+#endif // NAVGRAPH_H
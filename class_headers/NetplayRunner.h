@@ -0,0 +1,41 @@
+#ifndef NETPLAYRUNNER_H
+#define NETPLAYRUNNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RollbackSession.h"
+#include "UdpLink.h"
+
+struct NetplayOptions {
+    RollbackConfig rollback;
+    unsigned short localPort{7000};
+    std::string peerAddress{"127.0.0.1"};
+    unsigned short peerPort{7001};
+    LinkConditions conditions;
+    std::uint32_t ticks{0}; // 0 = until the window is closed
+    bool bot{false}; // pseudo-random inputs instead of the keyboard, for unattended soak runs
+    bool headless{false};
+};
+
+// two-player co-op over UDP with rollback, one process per player
+class NetplayRunner {
+    static constexpr unsigned int windowWidth{1600}, windowHeight{900};
+    static constexpr float stallTimeoutSeconds{5.f}; // peer considered gone after this long without progress
+    static constexpr float lingerSeconds{1.f}; // keep answering after the last tick so the peer can confirm it
+
+    NetplayOptions options;
+
+    static void printStats(const RollbackStats& stats, const UdpLink& link);
+
+public:
+    explicit NetplayRunner(NetplayOptions options);
+
+    int run() const; // process exit code: 0 ok, 3 desync, 4 peer lost
+
+    // `--netplay --slot 0|1 --port <n> --peer <host:port> [--delay <ticks>] [--rollback <ticks>]
+    //  [--latency <ms>] [--jitter <ms>] [--loss <0..1>] [--ticks <n>] [--bot] [--headless]`
+    static int runFromCommandLine(const std::vector<std::string>& args);
+};
+
+#endif //NETPLAYRUNNER_H
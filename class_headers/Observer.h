@@ -7,7 +7,7 @@
 class Observer {
 public:
     virtual ~Observer() = default;
-    virtual void onNotify(GameEvent event) = 0;
+    virtual void onNotify(const GameEventData& event) = 0;
 };
 
 #endif //OBSERVER_H
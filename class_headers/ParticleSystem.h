@@ -0,0 +1,84 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Observer.h"
+
+class EventBus;
+class RenderSnapshot;
+
+// fixed-capacity particle storage, one pool per texture so every pool draws as a single vertex batch
+struct ParticlePool {
+    std::vector<float> x, y; // centre, world px
+    std::vector<float> vx, vy; // px per second
+    std::vector<float> gravity; // px per second^2
+    std::vector<float> age, lifetime; // seconds
+    std::vector<float> halfSize;
+    std::vector<sf::Color> color; // alpha fades out with age
+    std::size_t count{0}; // live particles are [0, count), order is not kept
+    const sf::Texture* texture{nullptr}; // nullptr draws flat squares
+    sf::BlendMode blendMode{sf::BlendAlpha};
+
+    ParticlePool(std::size_t capacity, const sf::Texture* texture, const sf::BlendMode& blendMode);
+    std::size_t capacity() const { return x.size(); }
+};
+
+struct ParticleEmitter { // burst spawned for one gameplay event
+    std::size_t pool{0};
+    int count{0};
+    float minSpeed{}, maxSpeed{};
+    float minLifetime{}, maxLifetime{};
+    float halfSize{};
+    float gravity{};
+    sf::Color color;
+};
+
+struct ParticleStats {
+    std::size_t live{0};
+    std::size_t peak{0};
+    std::size_t dropped{0}; // not spawned because the budget or a pool was full
+};
+
+// visual feedback for hits, shots and deaths; driven by EventBus events, never part of the simulation or its snapshots
+class ParticleSystem : public Observer {
+    EventBus* eventBus;
+    sf::Texture sparkTexture; // soft dot generated at start-up
+    std::vector<ParticlePool> pools;
+    ParticleEmitter muzzleFlash, hitSparks, deathDebris;
+    std::size_t budget; // live particles over all pools, adjustable at runtime
+    ParticleStats stats;
+    std::minstd_rand rng; // cosmetic only, simulation randomness stays in GameRng
+
+    void emit(const ParticleEmitter& emitter, const sf::Vector2f& position);
+    static void removeExpired(ParticlePool& pool);
+
+public:
+    static constexpr std::size_t defaultCapacity{65536}; // per pool
+    static constexpr std::size_t defaultBudget{32768};
+
+    explicit ParticleSystem(EventBus* bus, std::size_t capacity = defaultCapacity, std::size_t initialBudget = defaultBudget);
+    ~ParticleSystem() override; // unsubscribes
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    void onNotify(const GameEventData& event) override;
+    void update(float dt); // move, age and drop expired particles
+    void clear();
+    void appendRenderItems(RenderSnapshot& out) const; // one VERTICES item per non-empty pool
+
+    void setBudget(std::size_t value); // clamped to the total capacity, particles above it are dropped at once
+    std::size_t getBudget() const;
+    const ParticleStats& getStats() const;
+
+    // vy += gravity * dt, then x += vx * dt, y += vy * dt and age += dt; SSE/AVX2 when available
+    static void integrate(float* x, float* y, const float* vx, float* vy, const float* gravity, float* age,
+                          std::size_t count, float dt);
+    static void integrateScalar(float* x, float* y, const float* vx, float* vy, const float* gravity, float* age,
+                                std::size_t count, float dt);
+};
+
+#endif //PARTICLESYSTEM_H
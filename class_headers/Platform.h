@@ -2,6 +2,9 @@
 #define PLATFORM_H
 
 #include <SFML/Graphics.hpp>
+#include <optional>
+
+class RenderSnapshot;
 
 class Platform {
     sf::RectangleShape shape; // rectangular shape
@@ -9,8 +12,13 @@ class Platform {
 public:
     Platform(float x, float y, float width, float height);
 
-    void draw(sf::RenderWindow& win) const;
+    void draw(sf::RenderTarget& target) const;
+    void appendRenderItems(RenderSnapshot& out) const;
     sf::FloatRect getBounds() const;
+    // swept landing on the top edge (one-way, from above): when box, moving by displacement this step,
+    // reaches the top with its bottom, the fraction of the step at which it does; nullopt when it misses.
+    // tolerance is how far below the top the box may start and still be put back on it.
+    std::optional<float> landingTime(const sf::FloatRect& box, const sf::Vector2f& displacement, float tolerance) const;
 };
 
 #endif //PLATFORM_H
\ No newline at end of file
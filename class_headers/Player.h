@@ -5,8 +5,13 @@
 #include <string>
 #include <vector>
 #include "Entity.h"
+#include "NavGraph.h"
 #include "Platform.h"
 #include "Subject.h"
+#include "PlayerInput.h"
+#include <memory>
+#include <span>
+#include <memory_resource>
 
 struct ProjectileSpawnInfo {
     sf::Vector2f position;
@@ -16,13 +21,14 @@ struct ProjectileSpawnInfo {
 
 class Player : public Entity, public Subject {
     // numeric constants
-    const float moveSpeed{4.8f};
-    const float gravityForce{0.7f};
-    const float jumpStrength{-18.0f};
-    const float defaultGroundY{900.f};
+    static constexpr float moveSpeed{4.8f};
+    static constexpr float gravityForce{0.7f};
+    static constexpr float jumpStrength{-18.0f};
+    static constexpr float defaultGroundY{900.f};
     const int shootCooldownFrames{13};
     const float projectileMoveSpeed{15.0f};
     const float dropThroughSpeed{3.0f};
+    const int maxHealthPoints{3};
 
     // flags
     bool isJumping{false};
@@ -32,7 +38,7 @@ class Player : public Entity, public Subject {
     int currentShootCooldown{0};
     bool facingRight{true};
     bool isShooting{false};
-    bool wantsToShootFlag{false};
+    bool invulnerable{false}; // stress runs keep the player alive
 
     // hitbox
     sf::RectangleShape hitboxShape_debug;
@@ -44,7 +50,8 @@ class Player : public Entity, public Subject {
            const std::string& initialTexturePath,
            int initialNumFrames,
            float initialAnimationInterval,
-           const sf::Vector2f& startPosition);
+           const sf::Vector2f& startPosition,
+           bool singletonInstance = true);
 
 public:
     // delete copy constructor and assignment operators for singleton
@@ -59,18 +66,26 @@ public:
         float initialAnimationInterval = 0.f,
         const sf::Vector2f& startPosition = {0, 0});
 
+    // second player for co-op, not the singleton, owned by World
+    static std::unique_ptr<Player> createCoopPartner(sf::RenderWindow* win, const sf::Vector2f& startPosition, std::pmr::memory_resource* resource = nullptr);
+
     // overridden base class functions
-    void draw() override;
-    void actions() override;
+    void draw(sf::RenderTarget& target) override;
+    void appendRenderItems(RenderSnapshot& out) const override;
     void update() override;
     void takeDamage() override;
 
-    void updater(const std::vector<Platform>& platforms);
+    void applyInput(const PlayerInput& input); // local, recorded or remote input for this tick
+    void updater(std::span<const Platform> platforms);
     sf::FloatRect getHitboxGlobalBounds() const;
     void jump();
-    bool wantsToShootProjectile() const;
-    ProjectileSpawnInfo getProjectileSpawnDetails();
+    ProjectileSpawnInfo getProjectileSpawnDetails() const;
     sf::FloatRect getCollisionBounds() const;
+    void setInvulnerable(bool value);
+    static JumpPhysics jumpPhysics(); // what the level is built around, walkers plan their jumps with it
+    void reset(const sf::Vector2f& startPosition); // full health, default flags, idle at startPosition
+    void saveState(SnapshotWriter& writer) const override;
+    void loadState(SnapshotReader& reader) override;
 };
 
 #endif // PLAYER_H
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef PLAYERINPUT_H
+#define PLAYERINPUT_H
+
+#include <cstdint>
+
+class InputSnapshot;
+
+// one tick of player controls as a bitmask, small enough to send every tick and compare cheaply
+struct PlayerInput {
+    enum Button : std::uint8_t {
+        LEFT = 1u << 0,
+        RIGHT = 1u << 1,
+        JUMP = 1u << 2,   // Z
+        SHOOT = 1u << 3,  // X
+        DROP = 1u << 4    // C, drop through a platform
+    };
+
+    std::uint8_t buttons{0};
+
+    bool has(Button button) const { return (buttons & button) != 0; }
+    void set(Button button, bool down) { buttons = down ? (buttons | button) : (buttons & ~button); }
+    friend bool operator==(const PlayerInput&, const PlayerInput&) = default;
+
+    static PlayerInput fromSnapshot(const InputSnapshot& snapshot); // this tick's keys, default bindings
+};
+
+#endif //PLAYERINPUT_H
@@ -12,13 +12,14 @@ public:
     Projectile(sf::RenderWindow* win, float x, float y, float dx, float dy, float projectileSpeed);
 
     // no implementations for member functions
-    void actions() override;
     void takeDamage() override;
     void update() override;
-    void draw() override;
+    void draw(sf::RenderTarget& target) override;
     void markForRemoval();
     bool isMarkedForRemoval() const;
     void checkOffScreen();
+    void applyIntegratedPosition(float x, float y); // position from World's projectile arrays, advances animation
+    void reset(float x, float y, float dx, float dy, float projectileSpeed); // reuse a pooled bullet
 };
 
 #endif // PROJECTILE_H
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef PROJECTILEKERNELS_H
+#define PROJECTILEKERNELS_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+
+// bullets stored as parallel float arrays so the kernels below can process 4/8 at once
+struct ProjectileArrays {
+    std::pmr::vector<float> x, y; // centre of the visual bounds
+    std::pmr::vector<float> vx, vy; // movement per tick
+    std::pmr::vector<float> halfWidth, halfHeight; // half extents of the visual bounds
+    std::pmr::vector<std::uint8_t> offScreen; // written by flagOutOfBounds
+    std::pmr::vector<std::uint8_t> hits; // written by overlapTarget
+    std::pmr::vector<float> hitTimes; // written by sweepTarget
+
+    explicit ProjectileArrays(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    std::size_t size() const { return x.size(); }
+    void reserve(std::size_t count);
+    void push(float px, float py, float pvx, float pvy, float hw, float hh);
+    void clear(); // keeps capacity
+    void moveElement(std::size_t from, std::size_t to); // used by stable compaction
+    void resize(std::size_t count);
+};
+
+// integration, off-screen and hit-test kernels, SSE/AVX2 when available with a scalar fallback
+class ProjectileKernels {
+public:
+    // x += vx, y += vy
+    static void integrate(float* x, float* y, const float* vx, const float* vy, std::size_t count);
+    // same rule as Projectile::checkOffScreen, 1 when the bullet left the area plus a margin of twice its size
+    static void flagOutOfBounds(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                std::size_t count, float areaWidth, float areaHeight, std::uint8_t* outFlags);
+    // 1 when the bullet's bounds intersect target (strict overlap, like sf::Rect::intersects)
+    static void overlapTarget(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                              std::size_t count, const sf::FloatRect& target, std::uint8_t* outFlags);
+    // time of impact in [0, 1) when the bullet overlapped target at any point of its last step, (x - vx, y - vy) to
+    // (x, y), +infinity when it did not; bullets faster than the target is thick cannot pass through it between two
+    // ticks, and the earliest time across targets tells which one the bullet reached first
+    static void sweepTarget(const float* x, const float* y, const float* vx, const float* vy,
+                            const float* halfWidth, const float* halfHeight,
+                            std::size_t count, const sf::FloatRect& target, float* outTimes);
+
+    // reference implementations, the vector paths must produce identical results
+    static void integrateScalar(float* x, float* y, const float* vx, const float* vy, std::size_t count);
+    static void flagOutOfBoundsScalar(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                      std::size_t count, float areaWidth, float areaHeight, std::uint8_t* outFlags);
+    static void overlapTargetScalar(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                    std::size_t count, const sf::FloatRect& target, std::uint8_t* outFlags);
+    static void sweepTargetScalar(const float* x, const float* y, const float* vx, const float* vy,
+                                  const float* halfWidth, const float* halfHeight,
+                                  std::size_t count, const sf::FloatRect& target, float* outTimes);
+
+    static const char* instructionSet(); // "AVX2", "SSE2" or "scalar"
+};
+
+#endif //PROJECTILEKERNELS_H
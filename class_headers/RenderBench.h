@@ -0,0 +1,42 @@
+#ifndef RENDERBENCH_H
+#define RENDERBENCH_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class RenderSnapshot;
+
+struct RenderBenchOptions {
+    std::vector<std::size_t> spriteCounts{1000, 5000, 10000, 25000, 50000};
+    std::size_t framesPerCount{120};
+    std::size_t warmupFrames{10}; // per count, not measured
+    unsigned int width{1600}, height{900};
+};
+
+struct RenderBenchResult {
+    std::size_t sprites{0};
+    double framesPerSecond{0.0}; // over the measured frames, including one read-back that waits for the GPU
+    double meanSubmitMs{0.0}; // CPU side of drawTo + display
+    double p99SubmitMs{0.0};
+};
+
+// draws RenderSnapshots into an off-screen sf::RenderTexture (Xvfb/Mesa is enough) and measures the draw path
+class RenderBench {
+    RenderBenchOptions options;
+
+public:
+    explicit RenderBench(RenderBenchOptions options);
+
+    // count orc sprites at seeded positions inside area, animation frames mixed; the same input gives the same frame
+    static void buildSpriteScene(RenderSnapshot& out, std::size_t count, sf::Vector2u area, unsigned int seed);
+
+    std::vector<RenderBenchResult> run() const; // throws GameError without a GL context
+    static void printResults(const std::vector<RenderBenchResult>& results);
+
+    // `--render-bench [--sprites 1000,5000,...] [--frames <n>]`
+    static int runFromCommandLine(const std::vector<std::string>& args);
+};
+
+#endif //RENDERBENCH_H
@@ -0,0 +1,57 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "RenderStats.h"
+
+// one draw call worth of state, plain data so a frame can be handed to another thread
+struct RenderItem {
+    enum class Kind : std::uint8_t { SPRITE, RECTANGLE, VERTICES }; // text is baked into VERTICES
+
+    Kind kind{Kind::SPRITE};
+    RenderLayer layer{RenderLayer::ENTITIES}; // only for the render counters, drawing order is the item order
+    const sf::Texture* texture{nullptr}; // SPRITE/VERTICES (may be null there), owned by TextureCache or a long-lived object
+    sf::IntRect textureRect; // SPRITE, the animation frame
+    sf::Vector2f size; // RECTANGLE
+    sf::Transform transform;
+    sf::Color fillColor{sf::Color::White}; // sprite tint or rectangle fill
+    sf::Color outlineColor{sf::Color::Transparent};
+    float outlineThickness{0.f};
+    std::uint32_t firstVertex{0}; // VERTICES, range in the snapshot's vertex list
+    std::uint32_t vertexCount{0};
+    sf::PrimitiveType primitive{sf::Quads}; // VERTICES
+    sf::BlendMode blendMode{sf::BlendAlpha}; // VERTICES
+};
+
+// everything one frame draws, in order; built by the simulation, drawn by FrameRenderer
+class RenderSnapshot {
+    std::vector<RenderItem> items;
+    std::vector<sf::Vertex> vertices; // batched geometry of every VERTICES item, capacity kept between frames
+    RenderLayer currentLayer{RenderLayer::ENTITIES};
+
+public:
+    void clear(); // keeps capacity, layer back to ENTITIES
+    void setLayer(RenderLayer layer); // tags every item added after it
+    void addSprite(const sf::Sprite& sprite); // skipped without a texture
+    void addRectangle(const sf::RectangleShape& shape);
+    void addRectangle(const sf::FloatRect& rect, sf::Color fill, sf::Color outline, float outlineThickness);
+    // bakes the glyphs into vertices on the building thread, the drawing thread only sees the font's page texture and
+    // never touches sf::Font; underline and strike-through are not drawn
+    void addText(const sf::Text& text);
+    // loads printable ASCII, regular and bold, for one font size on the calling thread before any baked text uses that
+    // glyph page; addText does it on first use, calling it while loading keeps the cost off a frame
+    static void prepareFont(const sf::Font& font, unsigned int characterSize, float outlineThickness = 0.f);
+    // one draw call of count vertices in world coordinates; fill the returned range before the next addVertices
+    std::span<sf::Vertex> addVertices(std::size_t count, sf::PrimitiveType primitive, const sf::Texture* texture,
+                                      const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+    void drawTo(sf::RenderTarget& target) const;
+    void drawTo(RenderStatsTarget& target) const; // counts draw calls, vertices and state changes per layer
+    std::size_t size() const;
+};
+
+#endif //RENDERSNAPSHOT_H
@@ -0,0 +1,59 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// what a draw belongs to, so the counters can tell the world from the overlays
+enum class RenderLayer : std::uint8_t { BACKGROUND, PLATFORMS, ENTITIES, PROJECTILES, PARTICLES, UI, COUNT };
+
+struct RenderCounters {
+    std::uint64_t drawCalls{0};
+    std::uint64_t vertices{0}; // submitted to SFML, quads counted as 4
+    std::uint64_t textureSwitches{0}; // draws whose texture differs from the previous draw's
+    std::uint64_t stateChanges{0}; // texture or blend mode differs from the previous draw's
+
+    RenderCounters& operator+=(const RenderCounters& other);
+};
+
+struct RenderStats {
+    std::array<RenderCounters, static_cast<std::size_t>(RenderLayer::COUNT)> layers{};
+
+    RenderCounters& operator[](RenderLayer layer) { return layers[static_cast<std::size_t>(layer)]; }
+    const RenderCounters& operator[](RenderLayer layer) const { return layers[static_cast<std::size_t>(layer)]; }
+    RenderStats& operator+=(const RenderStats& other);
+    RenderCounters total() const;
+    void clear();
+
+    static const char* layerName(RenderLayer layer);
+    // totals plus one line per layer that drew anything, divided by frames (1 for a single frame)
+    std::string format(double frames = 1.0) const;
+};
+
+// thin wrapper over a render target that counts what goes through it; the counts are estimates of what
+// SFML submits (it draws a sprite as 4 vertices, a rectangle as a fan plus an outline strip, text as 6 per glyph)
+class RenderStatsTarget {
+    sf::RenderTarget& target;
+    RenderStats& stats;
+    const void* lastTexture{nullptr}; // texture or font of the previous draw
+    sf::BlendMode lastBlendMode{sf::BlendAlpha};
+    bool first{true};
+
+    void count(RenderLayer layer, std::uint64_t vertices, std::uint64_t drawCalls, const void* textureKey, const sf::BlendMode& blendMode);
+
+public:
+    RenderStatsTarget(sf::RenderTarget& target, RenderStats& stats);
+
+    // textureKey stands in for whatever SFML binds for the drawable (a texture, or the font's page for text)
+    void draw(const sf::Drawable& drawable, RenderLayer layer, std::uint64_t vertices, std::uint64_t drawCalls,
+              const void* textureKey, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType primitive, RenderLayer layer,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+
+    sf::RenderTarget& getTarget() const;
+};
+
+#endif //RENDERSTATS_H
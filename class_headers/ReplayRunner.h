@@ -0,0 +1,61 @@
+#ifndef REPLAYRUNNER_H
+#define REPLAYRUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "InputRecording.h"
+#include "AllocationTracker.h"
+
+// limits a replay must stay within, loaded from a `key = value` file; unset keys are not checked
+struct ReplayBudget {
+    std::optional<double> maxP95FrameMs, maxP99FrameMs, maxFrameMs;
+    std::optional<double> maxMeanTickMs, maxP99TickMs;
+    std::optional<double> maxPeakEntities;
+    std::optional<double> maxAllocationsPerFrame; // mean over the frames after warm-up
+    std::optional<double> maxPeakAllocationsPerFrame; // worst single frame after warm-up
+    std::optional<double> maxPeakResidentMiB;
+    std::optional<double> maxAllocationViolationFrames; // frames that allocated inside an allocation-free phase
+
+    static ReplayBudget loadFromFile(const std::string& path); // throws ResourceLoadError/ConfigurationError
+};
+
+struct ReplayReport {
+    std::size_t frames{0};
+    bool reachedGameOver{false};
+    double p50FrameMs{0.0}, p95FrameMs{0.0}, p99FrameMs{0.0}, maxFrameMs{0.0};
+    double meanTickMs{0.0}, p99TickMs{0.0}; // input + simulation, without drawing
+    std::size_t peakEntities{0};
+    std::uint64_t totalAllocations{0};
+    double allocationsPerFrame{0.0};
+    std::uint64_t peakAllocationsPerFrame{0};
+    std::uint64_t allocationViolationFrames{0};
+    std::size_t frameArenaPeakBytes{0};
+    std::uint64_t frameArenaOverflowFrames{0}; // frames whose scratch did not fit the arena buffer
+    std::size_t worldArenaPeakBytes{0}; // entities, bullet arrays, platforms and spawn lanes at their peak
+    std::size_t peakResidentBytes{0};
+    std::uint64_t finalStateHash{0}; // FNV-1a of the final snapshot, equal on runs of the same build
+};
+
+// plays an InputRecording through World at a fixed tick, no keyboard or window focus involved
+class ReplayRunner {
+    static constexpr unsigned int windowWidth{1600}, windowHeight{900};
+    static constexpr std::size_t warmupFrames{60}; // first second fills caches and pools, excluded from allocation rates
+
+    InputRecording recording;
+    bool headless;
+
+public:
+    ReplayRunner(InputRecording recording, bool headless);
+
+    ReplayReport run(AllocationFrameLog& allocationLog) const;
+    static void printReport(const ReplayReport& report);
+    static std::vector<std::string> checkBudget(const ReplayReport& report, const ReplayBudget& budget); // one line per exceeded limit
+
+    // `--replay <recording> [--budget <file>] [--headless]`, exit code 3 when the budget is exceeded
+    static int runFromCommandLine(const std::vector<std::string>& args);
+};
+
+#endif //REPLAYRUNNER_H
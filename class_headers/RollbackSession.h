@@ -0,0 +1,88 @@
+#ifndef ROLLBACKSESSION_H
+#define ROLLBACKSESSION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "PlayerInput.h"
+
+class World;
+class EventBus;
+class UdpLink;
+
+struct RollbackConfig {
+    int localSlot{0}; // 0 = singleton player, 1 = co-op partner
+    std::uint32_t inputDelay{2}; // ticks between sampling a local input and applying it
+    std::uint32_t maxRollback{8}; // prediction window, the session stalls instead of predicting further
+    std::uint32_t redundantInputs{8}; // recent inputs repeated in every packet, covers packet loss
+    std::uint32_t checksumInterval{30}; // ticks between state hashes exchanged to detect desyncs
+};
+
+struct RollbackStats {
+    std::uint64_t ticks{0};
+    std::uint64_t rollbacks{0};
+    std::uint64_t rolledBackTicks{0}; // sum of rollback depths
+    std::uint32_t maxRollbackDepth{0};
+    std::uint64_t stalledTicks{0}; // frames spent waiting for the remote side
+    double resimulationSeconds{0.0}; // wall time spent re-simulating, including the restore
+    std::uint64_t checksumsCompared{0};
+    std::uint64_t desyncs{0};
+    std::int64_t firstDesyncTick{-1};
+    std::uint32_t remoteConfirmedTick{0}; // remote inputs are known for every tick below this
+};
+
+// GGPO-style rollback over World snapshots: predicts the remote input (repeat the last known one),
+// and when the real input disagrees restores the snapshot of that tick and re-simulates up to now
+class RollbackSession {
+public:
+    static constexpr float tickSeconds{1.f / 60.f}; // fixed tick, both peers must agree
+
+private:
+    static constexpr std::uint32_t historySize{256}; // input ring, must exceed maxRollback + inputDelay + redundantInputs
+    static constexpr std::uint32_t packetMagic{0x504E4C54}; // "TLNP"
+
+    World& world;
+    EventBus* eventBus;
+    UdpLink& link;
+    RollbackConfig config;
+    RollbackStats stats;
+
+    std::uint32_t currentTick{0}; // next tick to simulate
+    std::array<PlayerInput, historySize> localInputs{};
+    std::array<PlayerInput, historySize> remoteInputs{};
+    std::array<PlayerInput, historySize> remoteUsed{}; // what the simulation actually used, prediction or not
+    std::array<std::uint32_t, historySize> remoteInputTick{}; // which tick a remoteInputs slot holds, +1 (0 = empty)
+    std::uint32_t remoteContiguous{0}; // first tick whose remote input is still unknown
+    std::uint32_t newestLocalInputTick{0};
+    bool haveLocalInput{false};
+    std::int64_t rollbackTo{-1};
+
+    std::vector<std::vector<std::byte>> snapshots; // state before tick t at t % size
+    std::vector<std::int64_t> snapshotTick;
+    std::uint32_t nextChecksumTick;
+    std::map<std::uint32_t, std::uint64_t> localChecksums;
+    std::map<std::uint32_t, std::uint64_t> remoteChecksums;
+
+    void receivePackets();
+    void sendPacket();
+    void recordRemoteInput(std::uint32_t tick, PlayerInput input);
+    PlayerInput remoteInputFor(std::uint32_t tick) const; // confirmed or predicted
+    void simulateTick(std::uint32_t tick);
+    void rollback();
+    void updateChecksums();
+    static std::uint64_t hashBlob(const std::vector<std::byte>& blob); // FNV-1a
+
+public:
+    RollbackSession(World& world, EventBus* eventBus, UdpLink& link, const RollbackConfig& config);
+
+    // queues the local input and simulates at most one new tick; false while stalled on the remote peer
+    bool advance(const PlayerInput& localInput);
+    void pollNetwork(); // keep exchanging packets without advancing (shutdown linger)
+
+    std::uint32_t getCurrentTick() const;
+    const RollbackStats& getStats() const;
+};
+
+#endif //ROLLBACKSESSION_H
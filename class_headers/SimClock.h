@@ -0,0 +1,26 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include <SFML/System/Time.hpp>
+
+// sf::Clock replacement that reads simulated time, World advances it once per tick.
+// Pausing freezes every timer, and a clock is plain data so snapshots can copy it.
+class SimClock {
+    inline static double now{0.0}; // seconds of simulation, only written between ticks
+    double startTime{now};
+
+public:
+    sf::Time getElapsedTime() const { return sf::seconds(static_cast<float>(now - startTime)); }
+
+    sf::Time restart() {
+        sf::Time elapsed = getElapsedTime();
+        startTime = now;
+        return elapsed;
+    }
+
+    static void advance(float dt) { now += static_cast<double>(dt); }
+    static double getNow() { return now; }
+    static void setNow(double seconds) { now = seconds; } // snapshot restore
+};
+
+#endif //SIMCLOCK_H
@@ -0,0 +1,72 @@
+#ifndef SIMULATIONLOD_H
+#define SIMULATIONLOD_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+class Entity;
+
+enum class SimulationLevel : std::uint8_t {
+    FULL, // near a player: AI and animation every tick
+    REDUCED, // further away: AI and animation every few ticks, position stepped in between
+    SLEEPING // off-screen and far from everyone: not updated at all
+};
+
+enum class UpdateMode : std::uint8_t {
+    FULL, // run the entity's AI/animation with the time gathered since its last one
+    MOVE_ONLY, // Entity::stepMovement only
+    SKIP
+};
+
+// per-entity bookkeeping, part of the entity's snapshot so rollback re-simulates the same schedule
+struct SimulationLodState {
+    SimulationLevel level{SimulationLevel::FULL};
+    std::uint16_t ticksSinceUpdate{0};
+    float pendingSeconds{0.f}; // simulated time the entity's AI has not seen yet
+};
+
+struct SimulationLodConfig {
+    bool enabled{true};
+    float fullRadius{700.f}; // distance to the nearest player
+    float sleepRadius{1400.f}; // and outside the (grown) view
+    float viewMargin{200.f}; // the view grown by this counts as on-screen, actors wake before they show up
+    std::uint16_t reducedInterval{4}; // ticks between AI updates of a REDUCED entity
+    float maxCatchUpSeconds{0.25f}; // time handed to an entity on wake-up is capped, no burst of queued shots
+    std::size_t maxAiUpdatesPerTick{512}; // over this, the rest only move this tick and go first on the next one
+};
+
+struct SimulationLodStats {
+    std::size_t full{0}, reduced{0}, sleeping{0};
+    std::size_t aiUpdates{0};
+    std::size_t deferred{0}; // wanted an AI update but were over the per-tick cap
+};
+
+// decides once per tick, on the simulation thread, how much of each entity's update runs
+class SimulationScheduler {
+    SimulationLodConfig config;
+    std::size_t cursor{0}; // where the budgeted pass starts, rotates so deferred entities are served next
+    SimulationLodStats lastStats;
+
+public:
+    explicit SimulationScheduler(const SimulationLodConfig& config = {});
+
+    // one mode per entity; players are the live players' positions, view the visible world area
+    void schedule(std::span<const std::unique_ptr<Entity>> entities, std::span<const sf::Vector2f> players,
+                  const sf::FloatRect& view, std::pmr::vector<UpdateMode>& modes);
+    // run after schedule(): the entity's counters for this tick, and the seconds its AI update covers
+    float consumeTime(SimulationLodState& state, UpdateMode mode, float dt) const;
+
+    void setConfig(const SimulationLodConfig& newConfig);
+    const SimulationLodConfig& getConfig() const;
+    const SimulationLodStats& getLastStats() const;
+    std::size_t getCursor() const;
+    void setCursor(std::size_t newCursor); // snapshot restore
+};
+
+#endif //SIMULATIONLOD_H
@@ -0,0 +1,87 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "GameExceptions.h"
+
+// flat binary blob writer, values are copied as raw bytes (same build reads what it wrote)
+class SnapshotWriter {
+    std::vector<std::byte>& buffer;
+
+public:
+    explicit SnapshotWriter(std::vector<std::byte>& out) : buffer(out) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T, typename Allocator>
+    void writeArray(const std::vector<T, Allocator>& values) { // length prefix, then one memcpy
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+        write(static_cast<std::uint32_t>(values.size()));
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + values.size() * sizeof(T));
+        if (!values.empty()) std::memcpy(buffer.data() + offset, values.data(), values.size() * sizeof(T));
+    }
+
+    void writeString(const std::string& text) {
+        write(static_cast<std::uint32_t>(text.size()));
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + text.size());
+        std::memcpy(buffer.data() + offset, text.data(), text.size());
+    }
+};
+
+// reads back what SnapshotWriter produced, throws InvalidStateError on a truncated blob
+class SnapshotReader {
+    std::span<const std::byte> data;
+    std::size_t offset{0};
+
+    void require(std::size_t bytes) const {
+        if (bytes > data.size() - offset) throw InvalidStateError("Snapshot blob is truncated or corrupt");
+    }
+
+public:
+    explicit SnapshotReader(std::span<const std::byte> blob) : data(blob) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    template <typename T, typename Allocator>
+    void readArray(std::vector<T, Allocator>& values) {
+        const auto count = read<std::uint32_t>();
+        require(static_cast<std::size_t>(count) * sizeof(T));
+        values.resize(count);
+        if (count > 0) std::memcpy(values.data(), data.data() + offset, count * sizeof(T));
+        offset += count * sizeof(T);
+    }
+
+    std::string readString() {
+        const auto length = read<std::uint32_t>();
+        require(length);
+        std::string text(reinterpret_cast<const char*>(data.data() + offset), length);
+        offset += length;
+        return text;
+    }
+
+    bool atEnd() const { return offset == data.size(); }
+};
+
+#endif //SNAPSHOT_H
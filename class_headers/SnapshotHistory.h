@@ -0,0 +1,32 @@
+#ifndef SNAPSHOTHISTORY_H
+#define SNAPSHOTHISTORY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class World;
+
+// ring of periodic World snapshots (keyframes), buffers are reused so capturing does not allocate once warm
+class SnapshotHistory {
+    std::vector<std::vector<std::byte>> keyframes;
+    std::size_t nextSlot{0};
+    std::size_t stored{0};
+    float interval;
+    float sinceLastCapture{0.f};
+
+public:
+    explicit SnapshotHistory(std::size_t capacity = 10, float intervalSeconds = 0.5f);
+
+    bool update(float dt, const World& world); // captures when a keyframe is due, returns true if it did
+    bool rewind(World& world, std::size_t keyframesBack); // restores and drops the newer keyframes
+    void clear();
+    std::size_t size() const;
+    float getInterval() const;
+
+    // quick-save files, throw ResourceLoadError
+    static void writeFile(const std::string& path, const std::vector<std::byte>& blob);
+    static std::vector<std::byte> readFile(const std::string& path);
+};
+
+#endif //SNAPSHOTHISTORY_H
@@ -4,12 +4,14 @@
 #include <SFML/Audio.hpp>
 #include <map>
 #include <string>
+#include <vector>
 #include "Observer.h"
 #include "GameEvents.h"
 
 class SoundManager : public Observer {
     std::map<std::string, sf::SoundBuffer> soundBuffers; // stores actual audio data
     std::map<GameEvent, sf::Sound> eventActionSounds; // maps game events to playable sounds
+    std::map<std::string, std::string> bufferFiles; // normalised file path -> buffer name, for hot reload
     sf::Music introTheme; // specific intro
     sf::Music menuTheme; // specific menu loop
 
@@ -23,7 +25,7 @@ public:
     ~SoundManager() override = default;
 
     // core observer pattern implementation
-    void onNotify(GameEvent event) override;
+    void onNotify(const GameEventData& event) override;
 
     // players
     void playIntroTheme();
@@ -34,6 +36,9 @@ public:
     void stopMenuTheme();
     bool isMenuThemePlaying() const;
 
+    // hot reload: replaces the samples of the buffer loaded from path, the linked sounds keep using it; false when unknown
+    bool reloadSound(const std::string& path, const std::vector<sf::Int16>& samples, unsigned int channelCount, unsigned int sampleRate);
+
     // general volume controls
     void setGlobalSoundVolume(float volume);
     void setGlobalMusicVolume(float volume);
@@ -0,0 +1,57 @@
+#ifndef SPAWNCOMMANDBUFFER_H
+#define SPAWNCOMMANDBUFFER_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+
+enum class SpawnKind : std::uint8_t {
+    PLAYER_PROJECTILE,
+    MAGIC_PROJECTILE,
+    BERSERK_ORC,
+    MAGE_ORC
+};
+
+struct SpawnCommand {
+    SpawnKind kind;
+    sf::Vector2f position;
+    sf::Vector2f direction{0.f, 0.f}; // projectiles only
+    float speed{0.f}; // projectiles only
+};
+
+// per-tick spawn requests from any entity, one lane per job of the entity pass so writes never contend
+class SpawnCommandBuffer {
+    std::pmr::vector<std::pmr::vector<SpawnCommand>> lanes; // merged in lane order, which is entity order
+    std::size_t reservePerLane;
+
+    static thread_local std::size_t currentLane;
+
+public:
+    // sets the calling thread's lane for one job and puts it back to 0 afterwards
+    class LaneScope {
+    public:
+        explicit LaneScope(std::size_t lane) { currentLane = lane; }
+        ~LaneScope() { currentLane = 0; }
+        LaneScope(const LaneScope&) = delete;
+        LaneScope& operator=(const LaneScope&) = delete;
+    };
+
+    explicit SpawnCommandBuffer(std::size_t reservePerLane = 256, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void ensureLanes(std::size_t count); // only grows, new lanes get the same reserve; call outside the parallel pass
+    void push(const SpawnCommand& command); // appends to the calling job's lane
+    std::size_t totalCount() const;
+    std::size_t countOf(SpawnKind kind) const;
+    void clear(); // empties every lane, keeps the memory
+
+    template <typename F>
+    void forEach(F&& fn) const {
+        for (const auto& lane : lanes) {
+            for (const SpawnCommand& command : lane) fn(command);
+        }
+    }
+};
+
+#endif //SPAWNCOMMANDBUFFER_H
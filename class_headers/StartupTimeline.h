@@ -0,0 +1,66 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <chrono>
+#include <future>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// when each start-up step ran and on which thread, relative to the top of main; printed once the game is fully loaded
+class StartupTimeline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Span {
+        std::string name;
+        double startMs, endMs;
+        bool mainThread;
+    };
+
+    Clock::time_point origin;
+    std::thread::id mainThread;
+    mutable std::mutex mutex; // tasks record from their own threads
+    std::vector<Span> spans;
+
+public:
+    class Scope { // records from construction to destruction
+        StartupTimeline& timeline;
+        std::string name;
+        Clock::time_point start;
+
+    public:
+        Scope(StartupTimeline& timeline, std::string name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    StartupTimeline(); // origin is now, the calling thread is the main thread
+
+    // runs body on its own thread at once and records it; get() the future on the main thread to adopt the result
+    template <typename Function>
+    auto launch(std::string name, Function&& body) {
+        return std::async(std::launch::async, [this, name = std::move(name), body = std::forward<Function>(body)]() mutable {
+            Scope scope(*this, name);
+            return body();
+        });
+    }
+
+    void record(std::string name, Clock::time_point start, Clock::time_point end);
+    void mark(std::string name); // a moment, e.g. the first frame
+    double elapsedMs() const;
+    void print(std::ostream& out) const; // sorted by start, one bar per step on a shared time axis
+};
+
+// true once the future holds its value, without blocking
+template <typename T>
+bool isReady(const std::future<T>& future) {
+    return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+#endif //STARTUPTIMELINE_H
@@ -0,0 +1,44 @@
+#ifndef STRESSRUNNER_H
+#define STRESSRUNNER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "StressScenario.h"
+#include "RenderStats.h"
+
+struct StressReport {
+    std::string scenarioName;
+    std::size_t frames{0};
+    double p50FrameMs{0.0}, p95FrameMs{0.0}, p99FrameMs{0.0}, maxFrameMs{0.0};
+    double meanSimulationMs{0.0}, meanDrawMs{0.0};
+    std::size_t peakEntities{0};
+    double meanAiUpdates{0.0}, meanDeferredAiUpdates{0.0}, meanSleeping{0.0}; // per tick, from the simulation LOD
+    std::size_t peakParticles{0}, droppedParticles{0}; // 0 without a particle budget
+    RenderStats renderTotals; // over all frames, printed per frame
+    std::size_t peakResidentBytes{0}; // 0 when the platform does not report it
+    std::size_t snapshotBytes{0}; // final world state
+    double snapshotSaveUs{0.0}, snapshotLoadUs{0.0};
+};
+
+// runs a StressScenario through World/EntityFactory and measures every frame
+class StressRunner {
+    static constexpr float tickSeconds{1.f / 60.f}; // fixed step so every machine simulates the same work
+    static constexpr unsigned int windowWidth{1600}, windowHeight{900};
+
+    StressScenario scenario;
+    std::string saveSnapshotPath; // final state written here when set
+
+public:
+    static std::size_t peakResidentSetBytes();
+
+    explicit StressRunner(StressScenario scenario, std::string saveSnapshotPath = {});
+
+    StressReport run() const;
+    static void printReport(const StressReport& report);
+
+    // `--stress <scenario file> [--headless] [--save-snapshot <file>]`, returns the process exit code
+    static int runFromCommandLine(const std::vector<std::string>& args);
+};
+
+#endif //STRESSRUNNER_H
@@ -0,0 +1,28 @@
+#ifndef STRESSSCENARIO_H
+#define STRESSSCENARIO_H
+
+#include <string>
+#include "BulletPattern.h"
+
+// workload for the stress runner, loaded from a `key = value` text file
+struct StressScenario {
+    std::string name{"default"};
+    int berserkOrcs{50};
+    int mageOrcs{5};
+    float projectilesPerSecond{500.f}; // extra bullets on top of what the mages fire
+    float playerProjectileShare{0.5f}; // fraction of the extra bullets that fly as player shots (hit orcs)
+    int platforms{3};
+    float durationSeconds{10.f}; // simulated time, run at a fixed 60 Hz tick
+    unsigned int seed{1}; // placement and bullet directions
+    bool headless{false}; // hidden window, nothing presented on screen
+    std::string startSnapshot; // optional World snapshot file restored after the population is spawned
+    bool simulationLod{true}; // distant enemies update less often, 0 runs everything at full rate
+    int maxAiUpdatesPerTick{512};
+    int particleBudget{0}; // live hit/death particles, 0 leaves the particle system out
+    BulletPattern pattern{BulletPatterns::storm}; // preset fired by the pattern emitters, `pattern = <name>`
+    int patternEmitters{0}; // fixed emitters on the mage side firing `pattern` at the player, through the spawn buffer
+
+    static StressScenario loadFromFile(const std::string& path); // throws ResourceLoadError/ConfigurationError
+};
+
+#endif //STRESSSCENARIO_H
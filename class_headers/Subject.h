@@ -1,23 +1,22 @@
 #ifndef SUBJECT_H
 #define SUBJECT_H
 
-#include <vector>
-#include "Observer.h"
+#include <SFML/System/Vector2.hpp>
 #include "GameEvents.h"
 
-// subject class for observer
+class EventBus;
+
+// subject class for observer, events are queued on the bus instead of delivered inline
 class Subject {
-    std::vector<Observer*> observers;
+    EventBus* eventBus{nullptr};
 
 protected:
-    void notifyObservers(GameEvent event);
+    void notifyObservers(GameEvent event, const sf::Vector2f& position = {0.f, 0.f}, int entityId = -1) const;
 
 public:
     virtual ~Subject() = default;
 
-    void addObserver(Observer* observer);
-    void removeObserver(Observer* observer);
-
+    void setEventBus(EventBus* bus);
 };
 
 #endif //SUBJECT_H
@@ -0,0 +1,30 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// every texture is decoded and uploaded once, entities keep pointers into the cache
+class TextureCache {
+    std::map<std::string, std::unique_ptr<sf::Texture>> textures; // unique_ptr keeps addresses stable
+    mutable std::mutex mutex;
+
+    TextureCache() = default;
+
+public:
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    static TextureCache& getInstance();
+
+    const sf::Texture& get(const std::string& path); // loads on first use, throws ResourceLoadError
+    bool contains(const std::string& path) const;
+    // re-uploads a cached texture in place, so every pointer into the cache sees the new pixels; nullptr when not cached
+    sf::Texture* reload(const std::string& path, const sf::Image& image);
+    std::size_t size() const;
+};
+
+#endif //TEXTURECACHE_H
@@ -0,0 +1,11 @@
+#ifndef THREADAFFINITY_H
+#define THREADAFFINITY_H
+
+// best-effort core pinning for the simulation and render threads
+class ThreadAffinity {
+public:
+    static bool pinCurrentThread(unsigned int core); // false when unsupported (macOS) or refused
+    static unsigned int coreCount(); // at least 1
+};
+
+#endif //THREADAFFINITY_H
@@ -0,0 +1,19 @@
+#ifndef TIMINGSTATS_H
+#define TIMINGSTATS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// summary statistics shared by the stress, replay, render bench and frame pacer reports
+namespace TimingStats {
+    // nearest rank, sortedValues ascending; 0 for an empty list
+    inline double percentile(const std::vector<double>& sortedValues, double fraction) {
+        if (sortedValues.empty()) return 0.0;
+        auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sortedValues.size())));
+        return sortedValues[std::clamp<std::size_t>(rank, 1, sortedValues.size()) - 1];
+    }
+}
+
+#endif //TIMINGSTATS_H
@@ -0,0 +1,36 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// single producer / single consumer hand-off without locks: the producer always has a slot to write,
+// the consumer always reads the newest complete one, frames it never got to are overwritten
+template <typename T>
+class TripleBuffer {
+    static constexpr std::uint8_t indexMask{0x3};
+    static constexpr std::uint8_t freshBit{0x4}; // the middle slot holds a frame the consumer has not taken
+
+    std::array<T, 3> slots{};
+    std::atomic<std::uint8_t> middle{1};
+    std::uint8_t back{0}; // producer only
+    std::uint8_t front{2}; // consumer only
+
+public:
+    T& writeSlot() { return slots[back]; }
+
+    void publish() { // producer: the written slot becomes the newest, take the old middle to write next
+        back = middle.exchange(static_cast<std::uint8_t>(back | freshBit), std::memory_order_acq_rel) & indexMask;
+    }
+
+    bool acquire() { // consumer: false when nothing new was published since the last acquire
+        if ((middle.load(std::memory_order_acquire) & freshBit) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& readSlot() const { return slots[front]; }
+};
+
+#endif //TRIPLEBUFFER_H
@@ -0,0 +1,47 @@
+#ifndef UDPLINK_H
+#define UDPLINK_H
+
+#include <SFML/Network.hpp>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// artificial network conditions, applied on the sending side
+struct LinkConditions {
+    float latencyMs{0.f}; // one way
+    float jitterMs{0.f}; // +- uniformly around the latency, can reorder packets
+    float lossRate{0.f}; // 0..1
+};
+
+// non-blocking UDP socket to one peer, with optional simulated latency, jitter and loss
+class UdpLink {
+    using Clock = std::chrono::steady_clock;
+
+    struct DelayedPacket {
+        Clock::time_point due;
+        sf::Packet packet;
+    };
+
+    sf::UdpSocket socket;
+    sf::IpAddress remoteAddress;
+    unsigned short remotePort;
+    LinkConditions conditions;
+    std::mt19937 rng; // network conditions only, never touches the simulation
+    std::vector<DelayedPacket> outgoing;
+    std::size_t packetsSent{0};
+    std::size_t packetsDropped{0};
+
+public:
+    UdpLink(unsigned short localPort, const sf::IpAddress& remoteAddress, unsigned short remotePort,
+            const LinkConditions& conditions = {}); // throws ConfigurationError when the port cannot be bound
+
+    void send(const sf::Packet& packet); // queued until its simulated delivery time
+    void flush(); // puts due packets on the wire, call every tick
+    bool receive(sf::Packet& packet); // false when nothing from our peer is waiting
+
+    std::size_t getPacketsSent() const;
+    std::size_t getPacketsDropped() const;
+};
+
+#endif //UDPLINK_H
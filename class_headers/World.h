@@ -4,25 +4,74 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
-#include "SoundManager.h"
 #include "Platform.h"
+#include "JobSystem.h"
+#include "MageOrc.h"
+#include "Projectile.h"
+#include "MagicProjectile.h"
+#include "ProjectileKernels.h"
+#include "HandleTable.h"
+#include "SpawnCommandBuffer.h"
+#include "Snapshot.h"
+#include "PlayerInput.h"
+#include "RenderSnapshot.h"
+#include "FrameArena.h"
+#include "WorldArena.h"
+#include "SimulationLod.h"
+#include "NavGraph.h"
+#include <memory_resource>
+#include <span>
+#include <cstddef>
 
 // forward declarations
 class Entity;
 class Player;
 class MageOrc;
+class BerserkOrc;
 class EntityFactory;
+class EventBus;
+struct LevelSpec;
 
 
 
 class World {
+    struct CollisionTarget { // live enemy gathered once per tick for the collision passes
+        BerserkOrc* orc;
+        MageOrc* mage;
+        sf::FloatRect bounds;
+        bool isDead() const; // health gone; a mage stays in the world for its death animation
+        void takeDamage() const;
+    };
+
+    static constexpr std::size_t entityGrainSize{64}; // entities per job
+    static constexpr std::size_t projectileGrainSize{1024}; // bullets per job
+
     sf::RenderWindow* window;
+    WorldArena worldArena; // declared first: the objects of a run allocate from it, so it is released last and in bulk
     std::unique_ptr<EntityFactory> entityFactory; // hold the factory
-    std::vector<std::unique_ptr<Entity>> entities; // entities created by factory
-    std::vector<Platform> platforms; // separate vector for static platforms
-    SoundManager* soundManagerPtr; // observer for sounds
-    Player* playerPtr{nullptr}; // pointer to Player entity (singleton)
-    MageOrc* mageOrcPtr{nullptr}; // pointer to MageOrc entity (simulate a singleton)
+    std::pmr::vector<std::unique_ptr<Entity>> entities; // entities created by factory (enemies)
+    std::pmr::vector<std::unique_ptr<Projectile>> playerProjectiles; // index-aligned with playerProjectileData
+    ProjectileArrays playerProjectileData; // positions/velocities the kernels work on
+    std::pmr::vector<std::unique_ptr<MagicProjectile>> enemyProjectiles; // index-aligned with enemyProjectileData
+    ProjectileArrays enemyProjectileData;
+    std::size_t movedPlayerProjectiles{0}; // bullets integrated this tick, the ones after them were spawned after the move
+    std::size_t movedEnemyProjectiles{0};
+    std::pmr::vector<std::unique_ptr<Projectile>> spareProjectiles; // removed bullets kept for reuse
+    std::pmr::vector<std::unique_ptr<MagicProjectile>> spareMagicProjectiles;
+    std::pmr::vector<Platform> platforms; // separate vector for static platforms
+    EventBus* eventBus; // queued game events (sounds etc.)
+    RenderSnapshot drawScratch; // draw() goes through a snapshot too, reused every frame
+    std::vector<std::byte> loadBackup; // state before the running loadSnapshot, restored when the blob turns out bad
+    HandleTable<Entity> entityTable; // player and enemies, cross-entity references go through handles
+    EntityHandle playerHandle; // Player entity (singleton)
+    std::unique_ptr<Player> coopPlayer; // second player, only in co-op
+    EntityHandle coopPlayerHandle;
+    JobSystem jobSystem; // worker threads for the entity pass
+    SpawnCommandBuffer spawnCommands; // filled by any entity during the tick, one lane per job
+    FrameArena frameArena; // per-frame scratch of the tick, reset by the loop that owns this World
+    SimulationScheduler simulationScheduler; // how much of each enemy's update runs this tick
+    NavGraph navGraph; // walkable spans of the level, rebuilt when the platforms change
+    bool navGraphDirty{true};
 
     sf::Texture backgroundTexture;
     sf::Sprite backgroundSprite;
@@ -36,19 +85,72 @@ class World {
     void setupHealthDisplay();
     void updateHealthDisplay();
     void loadResources(); // load textures and assets
-    void createInitialEntitiesAndPlayer(); // player and enemies setup
+    void fitBackground(); // scale and centre the background sprite on the window
+    void createPlayer(); // Player singleton setup, once per World
+    Player* getPlayer() const; // nullptr once the handle is stale
+    Player* getCoopPlayer() const; // nullptr outside co-op
+    bool anyPlayerAlive() const;
+    void updatePlayer(Player* player);
+    EntityHandle addEntity(std::unique_ptr<Entity> entity); // register and store
+    void updateEntities(float dt); // parallel pass over entities
+    void rebuildNavGraph();
+    void planChases(); // serial: paths for the berserk orcs that are due, before the parallel pass
+    template <typename T>
+    void addProjectile(std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data, std::unique_ptr<T> bullet);
+    template <typename T>
+    void integrateProjectiles(std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data); // move + off-screen flags
+    template <typename T>
+    std::unique_ptr<T> acquireProjectile(std::pmr::vector<std::unique_ptr<T>>& spares, const SpawnCommand& command); // pooled or new
+    template <typename T>
+    static void compactProjectiles(std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data, std::pmr::vector<std::unique_ptr<T>>& spares);
     void checkCollisions(); // handle all collisions
+    static void projectileHitTimes(ProjectileArrays& data, std::size_t moved, const sf::FloatRect& target); // into data.hitTimes
     void removeMarkedEntities(); // delete dead or old entities
-    void spawnPlayerProjectiles(); // Projectile entity handler
-    void spawnEnemyProjectiles(); // MagicProjectile entity handler
+    void flushSpawnCommands(); // create everything requested this tick in one batch
+    static void saveProjectiles(SnapshotWriter& writer, const ProjectileArrays& data);
+    void readSnapshot(std::span<const std::byte> blob); // may throw halfway, loadSnapshot wraps it
+    void registerEntities(); // fresh handles for the players and every entity
+    template <typename T>
+    void loadProjectiles(SnapshotReader& reader, std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data, std::pmr::vector<std::unique_ptr<T>>& spares);
 
 public:
-    explicit World(sf::RenderWindow* win, std::unique_ptr<EntityFactory> factory, SoundManager* soundManagerPtr);
-    void handleInput() const; // handle player input
+    explicit World(sf::RenderWindow* win, std::unique_ptr<EntityFactory> factory, EventBus* bus);
+    ~World(); // defined where Player is complete
+    void reset(const LevelSpec& level); // back to the level's initial state, keeps resources and pools
+    void handleInput(const PlayerInput& first, const PlayerInput& second) const; // co-op/netplay, inputs per player slot
+    void enableCoop(); // adds the second player, takes effect from the next reset
+    bool hasCoop() const;
     void update(float dt); // call all update functions
-    void draw(); // call all draw functions
+    void draw(); // builds the frame and draws it right away
+    void draw(sf::RenderTarget& target); // same, into any target (e.g. an sf::RenderTexture for off-screen frames)
+    void draw(RenderStatsTarget& target); // same, counting the draws per layer
+    void buildRenderSnapshot(RenderSnapshot& out) const; // the frame as data, for a render thread
 
     bool isGameOver() const; // getter for game over
+
+    // whole simulation state as a flat blob, taken between ticks; out is reused so its capacity stays warm
+    void saveSnapshot(std::vector<std::byte>& out) const;
+    // throws InvalidStateError on a foreign/corrupt blob and leaves the world as it was before the call
+    void loadSnapshot(std::span<const std::byte> blob);
+
+    // used by the stress runner to build workloads through the regular spawn path
+    void queueSpawn(const SpawnCommand& command); // created by the next update's flush
+    void addPlatform(float x, float y, float width, float height);
+
+    // hot reload, between frames: entities showing a re-uploaded cache texture, the background image, the platform layout
+    std::size_t onTextureReloaded(const sf::Texture& texture); // entities patched, pooled bullets included
+    void reloadBackground(const sf::Image& image);
+    void applyLayout(const LevelSpec& level); // new platforms only, players, enemies and bullets keep their state
+    static constexpr const char* backgroundPath{"assets/backgrounds/background_1.png"};
+    void setPlayerInvulnerable(bool invulnerable) const;
+    std::size_t getEntityCount() const; // player, enemies and bullets
+    FrameArena& getFrameArena(); // reset() it at the top of every frame, before update()
+    const WorldArena& getWorldArena() const; // memory of this world, peak per run
+    void setSimulationLod(const SimulationLodConfig& config); // peers and replays must use the same config
+    const SimulationLodStats& getSimulationLodStats() const; // of the last tick
+    const NavGraphStats& getNavGraphStats() const; // size of the graph, searches and cache hits so far
+    static float berserkOrcGroundY(); // sprite Y that puts an orc's hitbox on the ground
+    static float playerGroundY();
 };
 
 #endif // WORLD_H
\ No newline at end of file
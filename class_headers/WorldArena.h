@@ -0,0 +1,58 @@
+#ifndef WORLDARENA_H
+#define WORLDARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+struct WorldArenaStats {
+    std::size_t bytesInUse{0}; // handed out and not returned yet
+    std::size_t runPeakBytes{0}; // most bytes in use at once since the run started
+    std::size_t heapBytes{0}; // the pools' chunks plus the large blocks, currently held from the heap
+};
+
+// memory for the objects of one run of a World (entities, bullets, bullet arrays, platforms). Objects freed during
+// the run go back to size-class pools and are reused by the next spawn; the pools take their chunks from a
+// monotonic buffer, so ending the run (reset or destruction) skips the per-object frees and hands the few large
+// buffers back to the heap at once. Blocks too big for the pools (grown bullet and entity vectors) come straight
+// from the heap and go back to it when freed, the monotonic buffer would keep every outgrown one until the run
+// ends. World declares it before anything allocated from it.
+// Not thread-safe: only the simulation thread allocates from it, job system workers never do (spawn lanes, which
+// they write, use the heap).
+class WorldArena : public std::pmr::memory_resource {
+    class HeapResource : public std::pmr::memory_resource { // the heap behind the pools, tracks what they hold
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    public:
+        std::atomic<std::size_t> held{0};
+    };
+
+    static constexpr std::size_t largestPooledBlock{4096}; // entities, bullets and small vectors
+
+    HeapResource heap;
+    std::pmr::monotonic_buffer_resource chunks; // grows geometrically, a run needs only a few heap buffers
+    std::pmr::unsynchronized_pool_resource pools;
+    std::size_t inUse{0};
+    std::size_t runPeak{0};
+    bool releasing{false}; // frees are no-ops, everything goes with release()
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    WorldArena();
+    WorldArena(const WorldArena&) = delete;
+    WorldArena& operator=(const WorldArena&) = delete;
+
+    // between the two, objects of the arena are destroyed without freeing them one by one; after release() nothing
+    // allocated before beginRelease() may be used again
+    void beginRelease();
+    void release(); // every buffer back to the heap, the peak starts again
+    WorldArenaStats getStats() const;
+    void printSummary() const;
+};
+
+#endif // WORLDARENA_H
@@ -0,0 +1,217 @@
+#include "../class_headers/AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+namespace {
+    constexpr std::size_t tagCount{static_cast<std::size_t>(AllocationTag::COUNT)};
+
+    struct TagCounters {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> violations{0};
+    };
+
+    // constant-initialised, usable from operator new before main and after static destruction
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> allocatedBytes{0};
+    std::atomic<std::uint64_t> freeCount{0};
+    std::atomic<bool> trackingEnabled{false};
+    TagCounters tagCounters[tagCount];
+
+    thread_local AllocationTag threadTag{AllocationTag::UNTAGGED}; // trivial, no TLS constructor inside operator new
+    thread_local bool threadAllocationFree{false};
+
+#ifdef TRACK_ALLOCATIONS
+    void recordAllocation(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        if (!trackingEnabled.load(std::memory_order_relaxed)) return;
+        TagCounters& counters = tagCounters[static_cast<std::size_t>(threadTag)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+        if (threadAllocationFree) counters.violations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* countedAllocate(std::size_t size) {
+        recordAllocation(size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* countedAllocate(std::size_t size, std::align_val_t alignment) {
+        recordAllocation(size);
+        const auto align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align; // aligned_alloc wants a multiple
+        return std::aligned_alloc(align, rounded);
+#endif
+    }
+
+    void countedFree(void* pointer) {
+        if (pointer) freeCount.fetch_add(1, std::memory_order_relaxed);
+        std::free(pointer);
+    }
+
+    void alignedFree(void* pointer) {
+        if (pointer) freeCount.fetch_add(1, std::memory_order_relaxed);
+#if defined(_WIN32)
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+#endif
+}
+
+bool AllocationTracker::isCompiledIn() {
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::uint64_t AllocationTracker::getAllocationCount() { return allocationCount.load(std::memory_order_relaxed); }
+
+std::uint64_t AllocationTracker::getAllocatedBytes() { return allocatedBytes.load(std::memory_order_relaxed); }
+
+std::uint64_t AllocationTracker::getFreeCount() { return freeCount.load(std::memory_order_relaxed); }
+
+void AllocationTracker::setEnabled(bool enabled) { trackingEnabled.store(enabled, std::memory_order_relaxed); }
+
+bool AllocationTracker::isEnabled() { return trackingEnabled.load(std::memory_order_relaxed); }
+
+AllocationTotals AllocationTracker::getTotals() {
+    AllocationTotals totals{};
+    for (std::size_t tag = 0; tag < tagCount; ++tag) {
+        totals[tag].allocations = tagCounters[tag].allocations.load(std::memory_order_relaxed);
+        totals[tag].bytes = tagCounters[tag].bytes.load(std::memory_order_relaxed);
+        totals[tag].violations = tagCounters[tag].violations.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+const char* AllocationTracker::tagName(AllocationTag tag) {
+    switch (tag) {
+        case AllocationTag::UNTAGGED: return "untagged";
+        case AllocationTag::INPUT: return "input";
+        case AllocationTag::SIMULATION: return "simulation";
+        case AllocationTag::SPAWNING: return "spawning";
+        case AllocationTag::COLLISION: return "collision";
+        case AllocationTag::EVENTS: return "events";
+        case AllocationTag::RENDER_BUILD: return "render build";
+        case AllocationTag::RENDERING: return "rendering";
+        case AllocationTag::UI: return "ui";
+        case AllocationTag::COUNT: break;
+    }
+    return "?";
+}
+
+AllocationScope::AllocationScope(AllocationTag tag, bool allocationFree) :
+    previousTag(threadTag), previousAllocationFree(threadAllocationFree) {
+    threadTag = tag;
+    threadAllocationFree = allocationFree;
+}
+
+AllocationScope::~AllocationScope() {
+    threadTag = previousTag;
+    threadAllocationFree = previousAllocationFree;
+}
+
+AllocationTag AllocationScope::currentTag() { return threadTag; }
+
+bool AllocationScope::currentIsAllocationFree() { return threadAllocationFree; }
+
+AllocationFrameLog::AllocationFrameLog(std::uint64_t warmupFrames) : warmupFrames(warmupFrames), warmupLeft(warmupFrames) {}
+
+void AllocationFrameLog::restartWarmup() { warmupLeft = warmupFrames; }
+
+void AllocationFrameLog::beginFrame() { frameStart = AllocationTracker::getTotals(); }
+
+void AllocationFrameLog::endFrame(std::uint64_t frameNumber) {
+    if (warmupLeft > 0) {
+        --warmupLeft;
+        return;
+    }
+    const AllocationTotals now = AllocationTracker::getTotals();
+    bool violated = false;
+    for (std::size_t tag = 0; tag < tagCount; ++tag) {
+        const std::uint64_t allocations = now[tag].allocations - frameStart[tag].allocations;
+        const std::uint64_t bytes = now[tag].bytes - frameStart[tag].bytes;
+        const std::uint64_t violations = now[tag].violations - frameStart[tag].violations;
+        sum[tag].allocations += allocations;
+        sum[tag].bytes += bytes;
+        sum[tag].violations += violations;
+        peakPerFrame[tag] = std::max(peakPerFrame[tag], allocations);
+        if (violations > 0) {
+            violated = true;
+            if (printedViolations < maxPrintedViolations) {
+                ++printedViolations;
+                std::cerr << "frame " << frameNumber << ": " << violations << " allocation(s) in allocation-free phase '"
+                          << AllocationTracker::tagName(static_cast<AllocationTag>(tag)) << "'\n";
+            }
+        }
+    }
+    ++frames;
+    if (violated) ++framesWithViolations;
+}
+
+void AllocationFrameLog::printSummary() const {
+    std::cout << "--- allocations over " << frames << " frames ---\n"
+              << std::left << std::setw(14) << "phase" << std::right << std::setw(12) << "allocs" << std::setw(14) << "bytes"
+              << std::setw(12) << "per frame" << std::setw(12) << "peak frame" << std::setw(12) << "violations" << "\n";
+    for (std::size_t tag = 0; tag < tagCount; ++tag) {
+        if (sum[tag].allocations == 0) continue;
+        const double perFrame = frames > 0 ? static_cast<double>(sum[tag].allocations) / static_cast<double>(frames) : 0.0;
+        std::cout << std::left << std::setw(14) << AllocationTracker::tagName(static_cast<AllocationTag>(tag)) << std::right
+                  << std::setw(12) << sum[tag].allocations << std::setw(14) << sum[tag].bytes
+                  << std::setw(12) << std::fixed << std::setprecision(2) << perFrame
+                  << std::setw(12) << peakPerFrame[tag] << std::setw(12) << sum[tag].violations << "\n";
+    }
+    std::cout << "frames with violations: " << framesWithViolations << std::endl;
+}
+
+std::uint64_t AllocationFrameLog::getFramesWithViolations() const { return framesWithViolations; }
+
+#ifdef TRACK_ALLOCATIONS
+// replaceable global allocation functions, every `new` in the program (SFML included) goes through these
+void* operator new(std::size_t size) {
+    if (void* pointer = countedAllocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* pointer = countedAllocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size); }
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = countedAllocate(size, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = countedAllocate(size, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { alignedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { alignedFree(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { alignedFree(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { alignedFree(pointer); }
+#endif
@@ -1,11 +1,14 @@
 #include "../class_headers/BerserkOrc.h"
 #include "../class_headers/Entity.h"
 #include "../class_headers/GameExceptions.h"
+#include "../class_headers/RenderSnapshot.h"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <iostream>
 #include <random>
-#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include "../class_headers/GameRng.h"
 
 void BerserkOrc::chooseNextState() {
     std::uniform_real_distribution idleDurationDist(2.0f, 4.0f);
@@ -20,8 +23,8 @@ void BerserkOrc::chooseNextState() {
         setAnimation("walk", 6, 0.15f);
 
         float currentX = getPosition().x;
-        float leftBoundary = originPoint.x - patrolRange;
-        float rightBoundary = originPoint.x + patrolRange;
+        float leftBoundary = patrolLeft;
+        float rightBoundary = patrolRight;
 
         if (currentX >= rightBoundary) {
             isMovingRight = false;
@@ -31,13 +34,13 @@ void BerserkOrc::chooseNextState() {
 
         velocity.x = isMovingRight ? speed : -speed;
         sprite.setScale(isMovingRight ? currentScaleX : -currentScaleX, currentScaleY);
-        std::cout << "Orc: Entering WALK state for " << currentStateDuration << "s. Dir: " << (isMovingRight?"Right":"Left") << std::endl;
+        // std::cout << "Orc: Entering WALK state for " << currentStateDuration << "s. Dir: " << (isMovingRight?"Right":"Left") << std::endl;
     } else { // go idle
         currentState = State::IDLE;
         currentStateDuration = idleDurationDist(rng);
         setAnimation("idle", 4, 0.2f);
         velocity.x = 0;
-        std::cout << "Orc: Entering IDLE state for " << currentStateDuration << "s." << std::endl;
+        // std::cout << "Orc: Entering IDLE state for " << currentStateDuration << "s." << std::endl;
     }
 
     stateTimer.restart();
@@ -45,7 +48,9 @@ void BerserkOrc::chooseNextState() {
 
 BerserkOrc::BerserkOrc(sf::RenderWindow* win, const sf::Vector2f& startPos) : Entity(win), // initialize base first
     originPoint(startPos),
-    rng(static_cast<unsigned long>(std::chrono::steady_clock::now().time_since_epoch().count())) {
+    patrolLeft(startPos.x - patrolRange),
+    patrolRight(startPos.x + patrolRange),
+    rng(GameRng::seedFrom(startPos.x, startPos.y, SimClock::getNow())) { // deterministic, peers must agree
     try {
         this->frameWidth = 96;
         this->frameHeight = 96;
@@ -95,9 +100,6 @@ BerserkOrc::BerserkOrc(sf::RenderWindow* win, const sf::Vector2f& startPos) : En
     }
 }
 
-// actual actions are computed inside update function
-void BerserkOrc::actions() {}
-
 void BerserkOrc::update() {
     if (healthPoints <= 0) {
         if (currentAnimationName == "death") {
@@ -108,12 +110,23 @@ void BerserkOrc::update() {
         return;
     }
 
+    if (chasing) { // the navigation pass decides where to go, only walk or fly here
+        moveAlongChase();
+        if (airborne || velocity.x != 0.f) {
+            setAnimation("walk", 6, 0.15f);
+        } else {
+            setAnimation("idle", 4, 0.2f);
+        }
+        Entity::update();
+        return;
+    }
+
     bool boundaryReached = false; // flag for maximum range reach
 
     if (currentState == State::WALKING) {
         float currentX = getPosition().x; // compute position
-        float leftBoundary = originPoint.x - patrolRange;
-        float rightBoundary = originPoint.x + patrolRange;
+        float leftBoundary = patrolLeft;
+        float rightBoundary = patrolRight;
 
         float nextX = currentX + velocity.x;
 
@@ -122,12 +135,12 @@ void BerserkOrc::update() {
             setPosition(rightBoundary, getPosition().y);
             velocity.x = 0;
             boundaryReached = true;
-            std::cout << "Orc: Reached right boundary." << std::endl;
+            // std::cout << "Orc: Reached right boundary." << std::endl;
         } else if (!isMovingRight && nextX <= leftBoundary) {
             setPosition(leftBoundary, getPosition().y);
             velocity.x = 0;
             boundaryReached = true;
-            std::cout << "Orc: Reached left boundary." << std::endl;
+            // std::cout << "Orc: Reached left boundary." << std::endl;
         }
 
         if (!boundaryReached) { // if boundary was reached stop entity
@@ -142,14 +155,122 @@ void BerserkOrc::update() {
     Entity::update(); // base class update function call
 }
 
-void BerserkOrc::draw() { // draw entity
-    if (window) {
-        window->draw(sprite);
-        sf::FloatRect globalBounds = getCollisionBounds(); // method
-        hitboxShape.setPosition(globalBounds.left, globalBounds.top);
-        hitboxShape.setSize({globalBounds.width, globalBounds.height});
-        window->draw(hitboxShape);
+void BerserkOrc::stepMovement() { // keeps walking, the boundary and the next state are left to the AI update
+    if (healthPoints <= 0) return;
+    if (chasing) {
+        moveAlongChase();
+        return;
     }
+    if (currentState != State::WALKING) return;
+    const float nextX = getPosition().x + velocity.x;
+    if (nextX > patrolLeft && nextX < patrolRight) {
+        sprite.move(velocity.x, 0.f);
+    }
+}
+
+float BerserkOrc::feetOffset() const {
+    const sf::FloatRect bounds = getCollisionBounds();
+    return bounds.top + bounds.height - getPosition().y;
+}
+
+sf::Vector2f BerserkOrc::getFeet() const {
+    const sf::FloatRect bounds = getCollisionBounds();
+    return {getPosition().x, bounds.top + bounds.height};
+}
+
+void BerserkOrc::moveAlongChase() {
+    constexpr float stopDistance{30.f}; // close enough to hit the target
+    if (airborne) {
+        airTicks += 1.f;
+        const sf::Vector2f feet = chaseLink.feetAt(airTicks);
+        setPosition(feet.x, feet.y - feetOffset());
+        if (airTicks >= chaseLink.airTicks) { // landed, stand still until the next plan
+            airborne = false;
+            hasLink = false;
+            chaseTargetX = spanLeft = spanRight = chaseLink.landingX;
+            replanCountdown = 0;
+        }
+        return;
+    }
+
+    const float goalX = hasLink ? chaseLink.takeoffX : chaseTargetX;
+    const float dx = goalX - getPosition().x;
+    if (hasLink && std::abs(dx) <= chaseSpeed) { // at the takeoff
+        setPosition(goalX, getPosition().y);
+        velocity.x = 0.f;
+        airborne = true;
+        airTicks = 0.f;
+        if (chaseLink.landingX != chaseLink.takeoffX) isMovingRight = chaseLink.landingX > chaseLink.takeoffX;
+        sprite.setScale(isMovingRight ? currentScaleX : -currentScaleX, currentScaleY);
+        return;
+    }
+    if (!hasLink && std::abs(dx) <= stopDistance) {
+        velocity.x = 0.f;
+        return;
+    }
+
+    const float nextX = std::clamp(getPosition().x + std::clamp(dx, -chaseSpeed, chaseSpeed), spanLeft, spanRight);
+    velocity.x = nextX - getPosition().x;
+    if (velocity.x == 0.f) return; // pressed against the end of the span
+    isMovingRight = velocity.x > 0.f;
+    sprite.setScale(isMovingRight ? currentScaleX : -currentScaleX, currentScaleY);
+    setPosition(nextX, getPosition().y);
+}
+
+bool BerserkOrc::dueForReplan(std::size_t slot, int interval) {
+    if (airborne) return false;
+    if (interval <= 1) return true;
+    if (replanCountdown < 0) replanCountdown = static_cast<std::int32_t>(slot % static_cast<std::size_t>(interval));
+    if (replanCountdown > 0) {
+        --replanCountdown;
+        return false;
+    }
+    replanCountdown = interval - 1;
+    return true;
+}
+
+void BerserkOrc::chaseTo(float targetX, float left, float right) {
+    chasing = true;
+    hasLink = false;
+    chaseTargetX = targetX;
+    spanLeft = left;
+    spanRight = right;
+}
+
+void BerserkOrc::chaseVia(const NavLink& link, float left, float right) {
+    chasing = true;
+    hasLink = true;
+    chaseLink = link;
+    spanLeft = left;
+    spanRight = right;
+}
+
+void BerserkOrc::stopChasing(float left, float right) {
+    if (!chasing) return;
+    chasing = false;
+    hasLink = false;
+    originPoint = getPosition();
+    patrolLeft = std::max(left, originPoint.x - patrolRange);
+    patrolRight = std::min(right, originPoint.x + patrolRange);
+    currentState = State::IDLE; // so the next state is a walk inside the new limits
+    chooseNextState();
+}
+
+bool BerserkOrc::isChasing() const { return chasing; }
+
+bool BerserkOrc::isAirborne() const { return airborne; }
+
+void BerserkOrc::draw(sf::RenderTarget& target) { // draw entity
+    target.draw(sprite);
+    sf::FloatRect globalBounds = getCollisionBounds(); // method
+    hitboxShape.setPosition(globalBounds.left, globalBounds.top);
+    hitboxShape.setSize({globalBounds.width, globalBounds.height});
+    target.draw(hitboxShape);
+}
+
+void BerserkOrc::appendRenderItems(RenderSnapshot& out) const {
+    out.addSprite(sprite);
+    out.addRectangle(getCollisionBounds(), hitboxShape.getFillColor(), hitboxShape.getOutlineColor(), hitboxShape.getOutlineThickness());
 }
 
 // position getter
@@ -159,21 +280,65 @@ sf::FloatRect BerserkOrc::getCollisionBounds() const {
 
 void BerserkOrc::takeDamage() {
     healthPoints--;
-    std::cout << "Orc took damage. HP: " << healthPoints << std::endl;
+    // std::cout << "Orc took damage. HP: " << healthPoints << std::endl;
     if (healthPoints <= 0 && !markedForRemoval) {
         markedForRemoval = true;
         setAnimation("death", 4, 0.2f);
         velocity = {0,0}; // stop moving
-        std::cout << "Orc marked for removal (dead)." << std::endl;
+        // std::cout << "Orc marked for removal (dead)." << std::endl;
     }
 }
 
 void BerserkOrc::markForRemoval() {
     if (!markedForRemoval) {
         markedForRemoval = true;
-        std::cout << "Orc marked for removal (external)." << std::endl;
+        // std::cout << "Orc marked for removal (external)." << std::endl;
     }
 }
 
 // getter for remove handling
-bool BerserkOrc::isMarkedForRemoval () const { return markedForRemoval; }
\ No newline at end of file
+bool BerserkOrc::isMarkedForRemoval () const { return markedForRemoval; }
+
+void BerserkOrc::saveState(SnapshotWriter& writer) const {
+    Entity::saveState(writer);
+    writer.write(currentState);
+    writer.write(originPoint);
+    writer.write(patrolLeft);
+    writer.write(patrolRight);
+    writer.write(isMovingRight);
+    writer.write(stateTimer);
+    writer.write(currentStateDuration);
+    writer.write(rng);
+    writer.write(markedForRemoval);
+    writer.write(chasing);
+    writer.write(hasLink);
+    writer.write(chaseLink);
+    writer.write(chaseTargetX);
+    writer.write(spanLeft);
+    writer.write(spanRight);
+    writer.write(airborne);
+    writer.write(airTicks);
+    writer.write(replanCountdown);
+}
+
+void BerserkOrc::loadState(SnapshotReader& reader) {
+    Entity::loadState(reader);
+    currentState = reader.read<State>();
+    originPoint = reader.read<sf::Vector2f>();
+    patrolLeft = reader.read<float>();
+    patrolRight = reader.read<float>();
+    isMovingRight = reader.read<bool>();
+    stateTimer = reader.read<SimClock>();
+    currentStateDuration = reader.read<float>();
+    rng = reader.read<GameRng>();
+    markedForRemoval = reader.read<bool>();
+    chasing = reader.read<bool>();
+    hasLink = reader.read<bool>();
+    chaseLink = reader.read<NavLink>();
+    chaseTargetX = reader.read<float>();
+    spanLeft = reader.read<float>();
+    spanRight = reader.read<float>();
+    airborne = reader.read<bool>();
+    airTicks = reader.read<float>();
+    replanCountdown = reader.read<std::int32_t>();
+}
\ No newline at end of file
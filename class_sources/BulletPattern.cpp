@@ -0,0 +1,82 @@
+#include "../class_headers/BulletPattern.h"
+#include <cmath>
+#include <numbers>
+
+DirectionTable::DirectionTable() {
+    for (std::size_t i = 0; i < resolution; ++i) {
+        const double angle = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(resolution);
+        directions[i] = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+    }
+}
+
+const DirectionTable& DirectionTable::getInstance() {
+    static const DirectionTable instance; // built once, thread-safe initialisation
+    return instance;
+}
+
+const sf::Vector2f& DirectionTable::at(float angleRadians) const {
+    constexpr float stepsPerRadian = static_cast<float>(resolution) / (2.f * std::numbers::pi_v<float>);
+    const auto step = static_cast<std::int64_t>(std::lround(angleRadians * stepsPerRadian));
+    return directions[static_cast<std::size_t>(step) & (resolution - 1)]; // two's complement wrap handles negatives
+}
+
+PatternEmitter::PatternEmitter(const BulletPattern& pattern) : pattern(pattern) {}
+
+void PatternEmitter::setPattern(const BulletPattern& newPattern) {
+    pattern = newPattern;
+    reset();
+}
+
+const BulletPattern& PatternEmitter::getPattern() const { return pattern; }
+
+void PatternEmitter::reset() {
+    volleyTimer = 0.f;
+    phase = 0.f;
+    volleysFired = 0;
+}
+
+int PatternEmitter::bulletCount() const {
+    return pattern.shape == PatternShape::SPIRAL ? pattern.arms : pattern.bulletsPerVolley;
+}
+
+float PatternEmitter::bulletsPerSecond() const {
+    return pattern.volleyInterval > 0.f ? static_cast<float>(bulletCount()) / pattern.volleyInterval : 0.f;
+}
+
+float PatternEmitter::firstAngle(float aimAngle) const {
+    switch (pattern.shape) {
+        case PatternShape::RING:
+        case PatternShape::SPIRAL:
+            return phase;
+        case PatternShape::AIMED_FAN:
+            return aimAngle - pattern.spreadRadians / 2.f;
+        case PatternShape::WAVE: {
+            // sine of the phase from the same table, no trig call per volley
+            float sweep = DirectionTable::getInstance().at(phase).y * pattern.spreadRadians;
+            return aimAngle + sweep - pattern.spreadRadians / 2.f;
+        }
+    }
+    return phase;
+}
+
+float PatternEmitter::angleStep() const {
+    const int count = bulletCount();
+    switch (pattern.shape) {
+        case PatternShape::RING:
+        case PatternShape::SPIRAL:
+            return count > 0 ? BulletPatterns::fullTurn / static_cast<float>(count) : 0.f;
+        case PatternShape::AIMED_FAN:
+        case PatternShape::WAVE:
+            return count > 1 ? pattern.spreadRadians / static_cast<float>(count - 1) : 0.f;
+    }
+    return 0.f;
+}
+
+const BulletPattern* BulletPatterns::findPreset(std::string_view name) {
+    if (name == "barrage_ring") return &barrageRing;
+    if (name == "flurry_shot") return &flurryShot;
+    if (name == "spiral") return &spiral;
+    if (name == "wave") return &wave;
+    if (name == "storm") return &storm;
+    return nullptr;
+}
@@ -2,17 +2,17 @@
 // specific factory methods
 
 std::unique_ptr<Entity> ConcreteEntityFactory::makeBerserkOrc(sf::RenderWindow* win, const sf::Vector2f& pos) {
-    return std::make_unique<BerserkOrc>(win, pos);
+    return create<BerserkOrc>(memoryResource, win, pos);
 }
 
 std::unique_ptr<Entity> ConcreteEntityFactory::makeMageOrc(sf::RenderWindow* win, const sf::Vector2f& pos) {
-    return std::make_unique<MageOrc>(win, pos);
+    return create<MageOrc>(memoryResource, win, pos);
 }
 
 std::unique_ptr<Entity> ConcreteEntityFactory::makeProjectile(sf::RenderWindow* win, float x, float y, float dx, float dy, float speed) {
-    return std::make_unique<Projectile>(win, x, y, dx, dy, speed);
+    return create<Projectile>(memoryResource, win, x, y, dx, dy, speed);
 }
 
 std::unique_ptr<Entity> ConcreteEntityFactory::makeMagicProjectile(sf::RenderWindow* win, float x, float y, float dx, float dy, float speed) {
-    return std::make_unique<MagicProjectile>(win, x, y, dx, dy, speed);
+    return create<MagicProjectile>(memoryResource, win, x, y, dx, dy, speed);
 }
\ No newline at end of file
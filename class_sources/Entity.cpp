@@ -1,20 +1,54 @@
 #include "../class_headers/Entity.h"
 #include "../class_headers/GameExceptions.h"
+#include "../class_headers/TextureCache.h"
+#include "../class_headers/RenderSnapshot.h"
 #include <iostream>
+#include <new>
+
+namespace {
+    struct AllocationHeader { // sits in front of every entity
+        std::pmr::memory_resource* resource;
+        std::size_t blockSize;
+    };
+    constexpr std::size_t blockAlignment{alignof(std::max_align_t)};
+    constexpr std::size_t headerSize{(sizeof(AllocationHeader) + blockAlignment - 1) / blockAlignment * blockAlignment};
+}
 
 // constructor sets the render window pointer
 Entity::Entity(sf::RenderWindow* win) : window(win) {}
 
+void* Entity::operator new(std::size_t size) {
+    return operator new(size, nullptr);
+}
+
+void* Entity::operator new(std::size_t size, std::pmr::memory_resource* resource) {
+    std::pmr::memory_resource* source = resource ? resource : std::pmr::new_delete_resource();
+    const std::size_t blockSize = headerSize + size;
+    auto* block = static_cast<std::byte*>(source->allocate(blockSize, blockAlignment));
+    ::new (block) AllocationHeader{source, blockSize};
+    return block + headerSize;
+}
+
+void Entity::operator delete(void* pointer) {
+    if (!pointer) return;
+    std::byte* block = static_cast<std::byte*>(pointer) - headerSize;
+    const AllocationHeader header = *std::launder(reinterpret_cast<AllocationHeader*>(block));
+    header.resource->deallocate(block, header.blockSize, blockAlignment);
+}
+
+void Entity::operator delete(void* pointer, std::pmr::memory_resource*) {
+    operator delete(pointer);
+}
+
 bool Entity::loadAnimationTexture(const std::string& animationName, const std::string& texturePath) {
     if (animationTextures.contains(animationName)) { return true; } // already loaded
 
-    sf::Texture tex;
-    if (!tex.loadFromFile(texturePath)) {
-        // throw error if texture fails to load
+    try { // decoded once per path, every entity of a kind shares the same texture
+        animationTextures[animationName] = &TextureCache::getInstance().get(texturePath);
+    } catch (const ResourceLoadError&) {
+        // rethrow with the animation that needed it
         throw ResourceLoadError("Texture (Animation)", texturePath, "Failed in Entity::loadAnimationTexture for animation: " + animationName);
     }
-    tex.setSmooth(false); // disable smoothing for pixel art
-    animationTextures[animationName] = tex; // store texture in map
     return true;
 }
 
@@ -31,7 +65,7 @@ void Entity::setAnimation(const std::string& animationName, int numFrames, float
         currentAnimationInterval = interval;
         currentFrameIndex = 0;
 
-        sprite.setTexture(animationTextures.at(animationName), true);
+        sprite.setTexture(*animationTextures.at(animationName), true);
 
         if (frameWidth <= 0 || frameHeight <= 0) {
             // throw error if frame size is invalid
@@ -73,6 +107,21 @@ void Entity::update() {
     }
 }
 
+bool Entity::onTextureReloaded(const sf::Texture& texture) {
+    if (sprite.getTexture() != &texture) return false;
+    if (frameWidth <= 0) { // single-image sprite (bullets), show the whole new image
+        sprite.setTexture(texture, true);
+        return true;
+    }
+    // a sheet that lost frames would leave the current one past its end
+    const int framesInSheet = static_cast<int>(texture.getSize().x) / frameWidth;
+    if (currentFrameIndex >= framesInSheet) currentFrameIndex = 0;
+    currentFrameRect.left = currentFrameIndex * frameWidth;
+    sprite.setTexture(texture, false);
+    sprite.setTextureRect(currentFrameRect);
+    return true;
+}
+
 // set sprite scale and store absolute scale
 void Entity::setScale(float scaleX, float scaleY) {
     currentScaleX = std::abs(scaleX);
@@ -86,11 +135,70 @@ sf::FloatRect Entity::getVisualBounds() const { return sprite.getGlobalBounds();
 // return sprite position
 sf::Vector2f Entity::getPosition() const { return sprite.getPosition(); }
 
+// return velocity per tick
+sf::Vector2f Entity::getVelocity() const { return velocity; }
+
 // set position by x and y
 void Entity::setPosition(float x, float y) { sprite.setPosition(x, y);}
 
 // set position by vector
 void Entity::setPosition(const sf::Vector2f& pos) { sprite.setPosition(pos); }
 
+// handle in World's entity table
+EntityHandle Entity::getHandle() const { return handle; }
+
+void Entity::setHandle(EntityHandle newHandle) { handle = newHandle; }
+
+void Entity::setSpawnBuffer(SpawnCommandBuffer* buffer) { spawnBuffer = buffer; }
+
+SimulationLodState& Entity::getLodState() { return lodState; }
+
+void Entity::stepMovement() { sprite.move(velocity); }
+
+void Entity::emitSpawn(const SpawnCommand& command) const {
+    if (spawnBuffer) spawnBuffer->push(command);
+}
+
 // return current health points
-int Entity::getHealthPoints() const { return healthPoints; }
\ No newline at end of file
+int Entity::getHealthPoints() const { return healthPoints; }
+
+void Entity::saveState(SnapshotWriter& writer) const {
+    writer.write(sprite.getPosition());
+    writer.write(sprite.getScale());
+    writer.write(velocity);
+    writer.write(healthPoints);
+    writer.writeString(currentAnimationName);
+    writer.write(currentNumFrames);
+    writer.write(currentAnimationInterval);
+    writer.write(currentFrameIndex);
+    writer.write(animationClock);
+    writer.write(lodState.level); // field by field, the struct's padding would make equal states hash differently
+    writer.write(lodState.ticksSinceUpdate);
+    writer.write(lodState.pendingSeconds);
+}
+
+void Entity::loadState(SnapshotReader& reader) {
+    sprite.setPosition(reader.read<sf::Vector2f>());
+    const auto scale = reader.read<sf::Vector2f>();
+    velocity = reader.read<sf::Vector2f>();
+    healthPoints = reader.read<int>();
+    const std::string animationName = reader.readString();
+    const int numFrames = reader.read<int>();
+    const float interval = reader.read<float>();
+    const int frameIndex = reader.read<int>();
+    const auto clock = reader.read<SimClock>();
+    lodState.level = reader.read<SimulationLevel>();
+    lodState.ticksSinceUpdate = reader.read<std::uint16_t>();
+    lodState.pendingSeconds = reader.read<float>();
+
+    if (animationTextures.contains(animationName)) {
+        setAnimation(animationName, numFrames, interval);
+        currentFrameIndex = frameIndex;
+        currentFrameRect.left = currentFrameIndex * frameWidth;
+        sprite.setTextureRect(currentFrameRect);
+    }
+    sprite.setScale(scale); // after setAnimation, which keeps the old facing
+    animationClock = clock;
+}
+
+void Entity::appendRenderItems(RenderSnapshot& out) const { out.addSprite(sprite); }
@@ -0,0 +1,58 @@
+#include "../class_headers/EventBus.h"
+#include "../class_headers/GameExceptions.h"
+#include <algorithm>
+#include <utility>
+
+EventBus::EventBus(std::size_t expectedEventsPerTick) {
+    // reserve once so posting never allocates in a normal tick
+    pending.reserve(expectedEventsPerTick);
+    delivering.reserve(expectedEventsPerTick);
+    mergeScratch.reserve(expectedEventsPerTick);
+}
+
+void EventBus::subscribe(Observer* observer, std::uint32_t typeMask, bool mergeDuplicates) {
+    if (!observer) { throw ConfigurationError("EventBus::subscribe called with nullptr observer."); }
+    auto it = std::ranges::find(subscriptions, observer, &Subscription::observer);
+    if (it != subscriptions.end()) { // resubscribing only updates the filter
+        it->typeMask = typeMask;
+        it->mergeDuplicates = mergeDuplicates;
+        return;
+    }
+    subscriptions.push_back({observer, typeMask, mergeDuplicates});
+}
+
+void EventBus::unsubscribe(Observer* observer) {
+    std::erase_if(subscriptions, [observer](const Subscription& s) { return s.observer == observer; });
+}
+
+void EventBus::post(const GameEventData& event) { pending.push_back(event); }
+
+void EventBus::post(GameEvent type, int entityId, const sf::Vector2f& position) {
+    pending.push_back({type, entityId, position});
+}
+
+void EventBus::dispatch() {
+    if (pending.empty()) return;
+    std::swap(pending, delivering); // swap keeps both capacities
+
+    for (std::size_t i = 0; i < subscriptions.size(); ++i) { // index loop, observers may subscribe meanwhile
+        const Subscription sub = subscriptions[i];
+        mergeScratch.clear();
+        for (const GameEventData& event : delivering) {
+            if (!(sub.typeMask & maskOf(event.type))) continue;
+            if (sub.mergeDuplicates) {
+                bool seen = std::ranges::any_of(mergeScratch, [&event](const GameEventData& e) {
+                    return e.type == event.type && e.entityId == event.entityId;
+                });
+                if (seen) continue;
+                mergeScratch.push_back(event);
+            }
+            sub.observer->onNotify(event);
+        }
+    }
+    delivering.clear();
+}
+
+std::size_t EventBus::pendingCount() const { return pending.size(); }
+
+void EventBus::discardPending() { pending.clear(); }
@@ -0,0 +1,41 @@
+#include "../class_headers/FrameArena.h"
+#include <algorithm>
+#include <iostream>
+
+FrameArena::FrameArena(std::size_t capacityBytes) :
+    buffer(std::make_unique<std::byte[]>(capacityBytes)),
+    arena(buffer.get(), capacityBytes, &overflow) {
+    stats.capacityBytes = capacityBytes;
+}
+
+void* FrameArena::OverflowResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::OverflowResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    frameBytes += bytes;
+    return arena.allocate(bytes, alignment);
+}
+
+void FrameArena::reset() {
+    stats.peakBytes = std::max(stats.peakBytes, frameBytes);
+    if (overflow.allocations != overflowAtFrameStart) ++stats.overflowFrames;
+    ++stats.frames;
+    frameBytes = 0;
+    arena.release(); // back to the start of the buffer, overflow blocks go back to the heap
+    overflowAtFrameStart = overflow.allocations;
+}
+
+std::size_t FrameArena::bytesThisFrame() const { return frameBytes; }
+
+const FrameArenaStats& FrameArena::getStats() const { return stats; }
+
+void FrameArena::printSummary() const {
+    std::cout << "Frame arena: peak " << stats.peakBytes / 1024 << " KiB of " << stats.capacityBytes / 1024
+              << " KiB per frame, " << stats.overflowFrames << " of " << stats.frames << " frames overflowed\n";
+}
@@ -0,0 +1,93 @@
+#include "../class_headers/FramePacer.h"
+#include "../class_headers/GameExceptions.h"
+#include "../class_headers/TimingStats.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FramePacer::FramePacer(sf::RenderWindow& window, PacingMode mode, float targetHz) :
+    mode(mode),
+    framePeriod(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(targetHz > 0.f ? 1.0 / targetHz : 0.0))) {
+    if (mode == PacingMode::TARGET_RATE && targetHz <= 0.f) {
+        throw ConfigurationError("Frame pacer target rate must be positive");
+    }
+    window.setFramerateLimit(0); // the pacer replaces SFML's limiter
+    window.setVerticalSyncEnabled(mode == PacingMode::VSYNC);
+    intervalsMs.reserve(historySize);
+    lastFrameStart = Clock::now();
+    nextDeadline = lastFrameStart + framePeriod;
+}
+
+void FramePacer::sleepThenSpin(Clock::time_point deadline) {
+    const Clock::time_point wakeTarget = deadline - spinMargin;
+    if (const Clock::time_point before = Clock::now(); wakeTarget > before) {
+        std::this_thread::sleep_until(wakeTarget);
+        // learn how late the scheduler wakes us, keep the margin a bit above it
+        const Clock::duration overshoot = Clock::now() - wakeTarget;
+        const Clock::duration wanted = std::clamp<Clock::duration>(overshoot + overshoot / 2, minSpinMargin, maxSpinMargin);
+        spinMargin = wanted > spinMargin ? wanted : spinMargin - (spinMargin - wanted) / 16; // rise fast, decay slowly
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield(); // the last stretch on the clock, no timer granularity involved
+    }
+}
+
+float FramePacer::waitForNextFrame() {
+    if (mode == PacingMode::TARGET_RATE) {
+        const Clock::time_point now = Clock::now();
+        if (nextDeadline < now - framePeriod) nextDeadline = now; // more than a frame late, do not burst to catch up
+        sleepThenSpin(nextDeadline);
+        nextDeadline += framePeriod; // fixed cadence, a late frame does not shift the following ones
+    }
+    const Clock::time_point frameStart = Clock::now();
+    const float dt = std::chrono::duration<float>(frameStart - lastFrameStart).count();
+    lastFrameStart = frameStart;
+    return dt;
+}
+
+void FramePacer::presented() {
+    const Clock::time_point now = Clock::now();
+    if (presentedOnce) {
+        const double intervalMs = std::chrono::duration<double, std::milli>(now - lastPresent).count();
+        if (intervalsMs.size() < historySize) {
+            intervalsMs.push_back(intervalMs);
+        } else {
+            intervalsMs[nextInterval] = intervalMs;
+        }
+        nextInterval = (nextInterval + 1) % historySize;
+    }
+    lastPresent = now;
+    presentedOnce = true;
+}
+
+void FramePacer::restartDelta() {
+    lastFrameStart = Clock::now();
+    nextDeadline = lastFrameStart + framePeriod;
+}
+
+PacingStats FramePacer::getStats() const {
+    PacingStats stats;
+    stats.samples = intervalsMs.size();
+    stats.spinMarginMs = std::chrono::duration<double, std::milli>(spinMargin).count();
+    if (intervalsMs.empty()) return stats;
+
+    double sum = 0.0;
+    for (double interval : intervalsMs) sum += interval;
+    stats.meanIntervalMs = sum / static_cast<double>(intervalsMs.size());
+
+    std::vector<double> deviations;
+    deviations.reserve(intervalsMs.size());
+    double squares = 0.0;
+    for (double interval : intervalsMs) {
+        const double deviation = interval - stats.meanIntervalMs;
+        squares += deviation * deviation;
+        deviations.push_back(std::abs(deviation));
+        stats.maxIntervalMs = std::max(stats.maxIntervalMs, interval);
+    }
+    stats.stdDevMs = std::sqrt(squares / static_cast<double>(intervalsMs.size()));
+    std::ranges::sort(deviations);
+    stats.p99DeviationMs = TimingStats::percentile(deviations, 0.99);
+    return stats;
+}
+
+PacingMode FramePacer::getMode() const { return mode; }
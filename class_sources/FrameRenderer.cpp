@@ -0,0 +1,99 @@
+#include "../class_headers/FrameRenderer.h"
+#include "../class_headers/FramePacer.h"
+#include "../class_headers/ThreadAffinity.h"
+#include "../class_headers/AllocationTracker.h"
+#include <iostream>
+
+FrameRenderer::FrameRenderer(sf::RenderWindow& window, FramePacer* pacer, bool threaded, int renderCore) :
+    window(window), pacer(pacer), threaded(threaded), renderCore(renderCore) {
+    if (!threaded) return;
+    if (!window.setActive(false)) { // a GL context can only be current on one thread
+        std::cerr << "Could not release the window context, rendering on the main thread\n";
+        this->threaded = false;
+        return;
+    }
+    renderThread = std::thread(&FrameRenderer::renderLoop, this);
+}
+
+FrameRenderer::~FrameRenderer() { stop(); }
+
+void FrameRenderer::present(const RenderSnapshot& snapshot) {
+    AllocationScope allocationScope(AllocationTag::RENDERING);
+    std::lock_guard presentLock(presentMutex);
+    window.clear();
+    frameStats.clear();
+    RenderStatsTarget counted(window, frameStats);
+    snapshot.drawTo(counted);
+    window.display();
+    {
+        std::lock_guard lock(statsMutex); // uncontended but for the overlay reading last frame's numbers
+        lastFrameStats = frameStats;
+        totalStats += frameStats;
+    }
+    renderedFrames.fetch_add(1, std::memory_order_relaxed);
+    if (pacer) pacer->presented(); // only the present timestamps, nothing the simulation thread touches
+}
+
+void FrameRenderer::renderLoop() {
+    if (renderCore >= 0 && !ThreadAffinity::pinCurrentThread(static_cast<unsigned int>(renderCore))) {
+        std::cerr << "Render thread could not be pinned to core " << renderCore << "\n";
+    }
+    if (!window.setActive(true)) {
+        std::cerr << "Render thread could not take the window context\n";
+        return;
+    }
+    std::uint64_t seen = 0;
+    while (!stopRequested.load(std::memory_order_acquire)) {
+        wakeSignal.wait(seen, std::memory_order_acquire); // sleeps until submit() or stop()
+        seen = wakeSignal.load(std::memory_order_acquire);
+        if (frames.acquire()) {
+            present(frames.readSlot());
+        }
+    }
+    window.setActive(false);
+}
+
+RenderSnapshot& FrameRenderer::beginFrame() {
+    RenderSnapshot& snapshot = frames.writeSlot();
+    snapshot.clear();
+    return snapshot;
+}
+
+void FrameRenderer::submit() {
+    publishedFrames.fetch_add(1, std::memory_order_relaxed);
+    if (!threaded) {
+        present(frames.writeSlot());
+        return;
+    }
+    frames.publish();
+    wakeSignal.fetch_add(1, std::memory_order_release);
+    wakeSignal.notify_one();
+}
+
+void FrameRenderer::stop() {
+    if (!renderThread.joinable()) return;
+    stopRequested.store(true, std::memory_order_release);
+    wakeSignal.fetch_add(1, std::memory_order_release);
+    wakeSignal.notify_one();
+    renderThread.join();
+    window.setActive(true);
+    threaded = false;
+}
+
+std::unique_lock<std::mutex> FrameRenderer::pauseRendering() { return std::unique_lock(presentMutex); }
+
+bool FrameRenderer::isThreaded() const { return threaded; }
+
+std::uint64_t FrameRenderer::getPublishedFrames() const { return publishedFrames.load(std::memory_order_relaxed); }
+
+std::uint64_t FrameRenderer::getRenderedFrames() const { return renderedFrames.load(std::memory_order_relaxed); }
+
+RenderStats FrameRenderer::getLastFrameStats() const {
+    std::lock_guard lock(statsMutex);
+    return lastFrameStats;
+}
+
+RenderStats FrameRenderer::getTotalStats() const {
+    std::lock_guard lock(statsMutex);
+    return totalStats;
+}
@@ -0,0 +1,169 @@
+#include "../class_headers/GoldenFrames.h"
+#include "../class_headers/RenderBench.h"
+#include "../class_headers/RenderSnapshot.h"
+#include "../class_headers/ParticleSystem.h"
+#include "../class_headers/World.h"
+#include "../class_headers/LevelSpec.h"
+#include "../class_headers/ConcreteEntityFactory.h"
+#include "../class_headers/EventBus.h"
+#include "../class_headers/PlayerInput.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+GoldenFrames::GoldenFrames(std::string directory, bool update, int channelTolerance, double maxDifferingFraction) :
+    directory(std::move(directory)), update(update), channelTolerance(channelTolerance), maxDifferingFraction(maxDifferingFraction) {
+    if (channelTolerance < 0 || channelTolerance > 255 || maxDifferingFraction < 0.0 || maxDifferingFraction > 1.0) {
+        throw ConfigurationError("Golden frame tolerance out of range");
+    }
+}
+
+ImageDiff GoldenFrames::compare(const sf::Image& actual, const sf::Image& expected, int channelTolerance) {
+    ImageDiff diff;
+    if (actual.getSize() != expected.getSize()) {
+        diff.sizeMismatch = true;
+        return diff;
+    }
+    const std::size_t pixels = static_cast<std::size_t>(actual.getSize().x) * actual.getSize().y;
+    const sf::Uint8* a = actual.getPixelsPtr();
+    const sf::Uint8* b = expected.getPixelsPtr();
+    for (std::size_t i = 0; i < pixels; ++i) {
+        int delta = 0;
+        for (std::size_t channel = 0; channel < 4; ++channel) { // RGBA
+            delta = std::max(delta, std::abs(static_cast<int>(a[i * 4 + channel]) - static_cast<int>(b[i * 4 + channel])));
+        }
+        diff.maxChannelDelta = std::max(diff.maxChannelDelta, delta);
+        if (delta > channelTolerance) ++diff.differingPixels;
+    }
+    return diff;
+}
+
+void GoldenFrames::writeDiffImage(const sf::Image& actual, const sf::Image& expected, int channelTolerance, const std::string& path) {
+    const sf::Vector2u size = actual.getSize();
+    sf::Image diffImage;
+    diffImage.create(size.x, size.y, sf::Color::Black);
+    for (unsigned int y = 0; y < size.y; ++y) {
+        for (unsigned int x = 0; x < size.x; ++x) {
+            const sf::Color a = actual.getPixel(x, y);
+            const sf::Color b = expected.getPixel(x, y);
+            const int delta = std::max({std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b), std::abs(a.a - b.a)});
+            const auto dimmed = static_cast<sf::Uint8>((b.r + b.g + b.b) / 12); // faint reference for orientation
+            diffImage.setPixel(x, y, delta > channelTolerance ? sf::Color::Red : sf::Color(dimmed, dimmed, dimmed));
+        }
+    }
+    if (!diffImage.saveToFile(path)) std::cerr << "Could not write " << path << "\n";
+}
+
+int GoldenFrames::run() const {
+    // World needs a window for its size and GL context; it stays hidden, every frame goes to the render texture
+    sf::RenderWindow window(sf::VideoMode({frameWidth, frameHeight}), "ToonLander golden frames", sf::Style::Default);
+    window.setVisible(false);
+    EventBus eventBus; // gameplay events are dropped, the particle scene is fed directly
+    World world(&window, std::make_unique<ConcreteEntityFactory>(), &eventBus);
+    ParticleSystem particles(nullptr, 4096, 4096);
+
+    sf::RenderTexture target;
+    if (!target.create(frameWidth, frameHeight)) {
+        throw GameError("Golden frames could not create a render texture (no GL context? try xvfb-run)");
+    }
+
+    const std::vector<Scene> scenes = {
+        {"sprites", [](RenderSnapshot& out) { RenderBench::buildSpriteScene(out, 2000, {frameWidth, frameHeight}, 7); }},
+        {"level_start", [&](RenderSnapshot& out) {
+            world.reset(LevelSpec::defaultLevel(window.getSize()));
+            world.buildRenderSnapshot(out);
+        }},
+        {"level_two_seconds", [&](RenderSnapshot& out) { // idle player, enemies run their own AI
+            world.reset(LevelSpec::defaultLevel(window.getSize()));
+            for (int tick = 0; tick < 120; ++tick) {
+                world.handleInput({}, {});
+                world.update(1.f / 60.f);
+            }
+            eventBus.discardPending();
+            world.buildRenderSnapshot(out);
+        }},
+        {"particles", [&](RenderSnapshot& out) {
+            particles.clear();
+            particles.onNotify({GameEvent::ENEMY_DIED, -1, {800.f, 450.f}});
+            for (int i = 0; i < 8; ++i) {
+                particles.onNotify({GameEvent::PROJECTILE_HIT, -1, {200.f + 150.f * static_cast<float>(i), 300.f}});
+                particles.onNotify({GameEvent::PLAYER_FIRED, -1, {200.f + 150.f * static_cast<float>(i), 700.f}});
+            }
+            for (int frame = 0; frame < 6; ++frame) particles.update(1.f / 60.f);
+            particles.appendRenderItems(out);
+        }},
+    };
+
+    if (update) std::filesystem::create_directories(directory);
+    int failures = 0;
+    RenderSnapshot frame;
+    for (const Scene& scene : scenes) {
+        frame.clear();
+        scene.build(frame);
+        target.setView(target.getDefaultView());
+        target.clear();
+        frame.drawTo(target);
+        target.display();
+        const sf::Image actual = target.getTexture().copyToImage();
+
+        const std::string path = directory + "/" + scene.name + ".png";
+        if (update) {
+            if (!actual.saveToFile(path)) throw ResourceLoadError("Golden image", path, "could not be written");
+            std::cout << "golden " << scene.name << ": updated " << path << "\n";
+            continue;
+        }
+
+        sf::Image expected;
+        if (!expected.loadFromFile(path)) {
+            std::cout << "golden " << scene.name << ": MISSING " << path << " (run with --update-golden on the reference setup)\n";
+            ++failures;
+            continue;
+        }
+        const ImageDiff diff = compare(actual, expected, channelTolerance);
+        const auto allowed = static_cast<std::size_t>(maxDifferingFraction * static_cast<double>(frameWidth) * frameHeight);
+        const bool passed = !diff.sizeMismatch && diff.differingPixels <= allowed;
+        std::cout << "golden " << scene.name << ": " << (passed ? "ok" : "MISMATCH");
+        if (diff.sizeMismatch) {
+            std::cout << " (size " << expected.getSize().x << "x" << expected.getSize().y << ")\n";
+        } else {
+            std::cout << " (" << diff.differingPixels << " px differ, allowed " << allowed << ", max channel delta " << diff.maxChannelDelta << ")\n";
+        }
+        if (passed) continue;
+        ++failures;
+        const std::string stem = directory + "/" + scene.name;
+        if (!actual.saveToFile(stem + ".actual.png")) std::cerr << "Could not write " << stem << ".actual.png\n";
+        if (!diff.sizeMismatch) writeDiffImage(actual, expected, channelTolerance, stem + ".diff.png");
+    }
+    return failures;
+}
+
+int GoldenFrames::runFromCommandLine(const std::vector<std::string>& args) {
+    try {
+        std::string directory = "assets/golden";
+        auto goldenArg = std::ranges::find(args, "--golden");
+        if (goldenArg != args.end() && std::next(goldenArg) != args.end() && !std::next(goldenArg)->starts_with("--")) {
+            directory = *std::next(goldenArg);
+        }
+        int tolerance = 2;
+        if (auto toleranceArg = std::ranges::find(args, "--tolerance"); toleranceArg != args.end() && std::next(toleranceArg) != args.end()) {
+            tolerance = std::stoi(*std::next(toleranceArg));
+        }
+        const bool update = std::ranges::find(args, "--update-golden") != args.end();
+        GoldenFrames golden(std::move(directory), update, tolerance);
+        const int failures = golden.run();
+        if (failures > 0) std::cerr << failures << " golden frame(s) failed\n";
+        return failures == 0 ? 0 : 4;
+    } catch (const GameError& e) {
+        std::cerr << "\n--- GOLDEN FRAMES FAILED ---\n" << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "\n--- STANDARD EXCEPTION CAUGHT ---\n" << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,254 @@
+#include "../class_headers/HotReloader.h"
+#include "../class_headers/World.h"
+#include "../class_headers/SoundManager.h"
+#include "../class_headers/TextureCache.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::string normalise(const std::filesystem::path& path) { return path.lexically_normal().generic_string(); }
+
+    std::string lowerExtension(const std::string& path) {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    bool isTexture(const std::string& extension) {
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".tga";
+    }
+
+    bool isSound(const std::string& extension) { return extension == ".wav" || extension == ".ogg" || extension == ".flac"; }
+
+    const char* kindName(DecodedAsset::Kind kind) {
+        switch (kind) {
+            case DecodedAsset::Kind::TEXTURE: return "texture";
+            case DecodedAsset::Kind::SOUND: return "sound";
+            case DecodedAsset::Kind::LEVEL: return "level";
+        }
+        return "?";
+    }
+}
+
+bool HotReloader::supported() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+HotReloader::HotReloader(std::vector<std::string> roots, const std::string& levelPath) :
+    roots(std::move(roots)), levelPath(levelPath.empty() ? std::string{} : normalise(levelPath)) {
+#if defined(__linux__)
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) throw ConfigurationError("Hot reload could not create an inotify instance");
+    try {
+        for (const std::string& root : this->roots) addWatch(root);
+        if (!this->levelPath.empty()) { // the level may live outside the asset roots
+            const std::filesystem::path levelDirectory = std::filesystem::path(this->levelPath).parent_path();
+            addWatch(levelDirectory.empty() ? std::string(".") : levelDirectory.string());
+        }
+    } catch (...) {
+        close(inotifyFd); // the destructor does not run for a failed constructor
+        throw;
+    }
+    watcherThread = std::thread(&HotReloader::watchLoop, this);
+#else
+    throw ConfigurationError("Hot reload needs inotify, it is only available on Linux");
+#endif
+}
+
+HotReloader::~HotReloader() {
+    stopRequested.store(true, std::memory_order_release);
+    if (watcherThread.joinable()) watcherThread.join(); // wakes within one poll timeout
+#if defined(__linux__)
+    if (inotifyFd >= 0) close(inotifyFd); // drops every watch with it
+#endif
+}
+
+void HotReloader::addWatch(const std::string& directory) {
+#if defined(__linux__)
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        throw ConfigurationError("Hot reload cannot watch '" + directory + "', not a directory");
+    }
+    std::vector<std::string> directories{normalise(directory)};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) { // inotify is not recursive
+        if (entry.is_directory()) directories.push_back(normalise(entry.path()));
+    }
+    for (const std::string& path : directories) {
+        const int watch = inotify_add_watch(inotifyFd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (watch < 0) throw ConfigurationError("Hot reload could not watch '" + path + "' (inotify watch limit?)");
+        watchedDirectories[watch] = path;
+    }
+#else
+    (void)directory;
+#endif
+}
+
+void HotReloader::readEvents() {
+#if defined(__linux__)
+    alignas(inotify_event) char buffer[4096];
+    const auto now = std::chrono::steady_clock::now();
+    for (;;) {
+        const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break; // EAGAIN, drained
+        for (const char* cursor = buffer; cursor < buffer + length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                std::cerr << "Hot reload: inotify queue overflowed, some changes were missed\n";
+                continue;
+            }
+            auto directory = watchedDirectories.find(event->wd);
+            if (directory == watchedDirectories.end() || event->len == 0) continue;
+            const std::string path = normalise(std::filesystem::path(directory->second) / event->name);
+            if (event->mask & IN_ISDIR) { // a new subdirectory gets its own watch
+                try {
+                    addWatch(path);
+                } catch (const std::exception& e) {
+                    std::cerr << "Hot reload: " << e.what() << "\n";
+                }
+                continue;
+            }
+            const std::string extension = lowerExtension(path);
+            if (path == levelPath || isTexture(extension) || isSound(extension)) changed[path] = now;
+        }
+    }
+#endif
+}
+
+bool HotReloader::decode(const std::string& path, DecodedAsset& out) const {
+    out.path = path;
+    const std::string extension = lowerExtension(path);
+    if (path == levelPath) {
+        out.kind = DecodedAsset::Kind::LEVEL;
+        try {
+            out.level = LevelSpec::loadFromFile(path);
+        } catch (const GameError& e) {
+            std::cerr << "Hot reload: " << e.what() << "\n";
+            return false;
+        }
+        return true;
+    }
+    if (isTexture(extension)) {
+        out.kind = DecodedAsset::Kind::TEXTURE;
+        return out.image.loadFromFile(path); // CPU decode only, the upload waits for the frame boundary
+    }
+    out.kind = DecodedAsset::Kind::SOUND;
+    sf::InputSoundFile file;
+    if (!file.openFromFile(path)) return false;
+    out.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+    out.channelCount = file.getChannelCount();
+    out.sampleRate = file.getSampleRate();
+    return file.read(out.samples.data(), out.samples.size()) == out.samples.size();
+}
+
+void HotReloader::decodeSettled() {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = changed.begin(); it != changed.end();) {
+        if (now - it->second < settleTime) {
+            ++it;
+            continue;
+        }
+        DecodedAsset asset;
+        const auto start = std::chrono::steady_clock::now();
+        const bool decoded = decode(it->first, asset);
+        asset.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        {
+            std::lock_guard lock(readyMutex);
+            if (decoded) {
+                ready.push_back(std::move(asset));
+            } else {
+                std::cerr << "Hot reload: could not decode " << it->first << ", keeping the loaded version\n";
+                ++failedDecodes;
+            }
+            readyCount.store(ready.size(), std::memory_order_release);
+        }
+        it = changed.erase(it);
+    }
+}
+
+void HotReloader::watchLoop() {
+#if defined(__linux__)
+    pollfd watched{inotifyFd, POLLIN, 0};
+    while (!stopRequested.load(std::memory_order_acquire)) {
+        if (poll(&watched, 1, 50) > 0 && (watched.revents & POLLIN)) readEvents(); // the timeout also checks stop and settled files
+        decodeSettled();
+    }
+#endif
+}
+
+bool HotReloader::hasPending() const { return readyCount.load(std::memory_order_acquire) > 0; }
+
+bool HotReloader::applyPending(World* world, SoundManager* sounds, LevelSpec& level) {
+    std::vector<DecodedAsset> batch;
+    {
+        std::lock_guard lock(readyMutex);
+        batch.swap(ready);
+        stats.failed += failedDecodes;
+        failedDecodes = 0;
+        readyCount.store(0, std::memory_order_release);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    bool layoutChanged = false;
+    for (const DecodedAsset& asset : batch) {
+        const auto start = Clock::now();
+        std::size_t patched = 0;
+        try {
+            bool used = true;
+            switch (asset.kind) {
+                case DecodedAsset::Kind::TEXTURE:
+                    if (sf::Texture* texture = TextureCache::getInstance().reload(asset.path, asset.image)) {
+                        if (world) patched = world->onTextureReloaded(*texture);
+                    } else if (world && asset.path == World::backgroundPath) {
+                        world->reloadBackground(asset.image);
+                    } else {
+                        used = false; // not loaded yet, the first use reads the new file anyway
+                    }
+                    break;
+                case DecodedAsset::Kind::SOUND:
+                    used = sounds && sounds->reloadSound(asset.path, asset.samples, asset.channelCount, asset.sampleRate);
+                    break;
+                case DecodedAsset::Kind::LEVEL:
+                    level = asset.level; // the next start spawns the new enemies and player position
+                    if (world) {
+                        world->applyLayout(asset.level);
+                        layoutChanged = true;
+                    }
+                    break;
+            }
+            if (!used) continue;
+        } catch (const GameError& e) {
+            std::cerr << "Hot reload of " << asset.path << " failed: " << e.what() << "\n";
+            ++stats.failed;
+            continue;
+        }
+        ++stats.reloaded;
+        stats.patchedEntities += patched;
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2) << "Hot reload: " << asset.path << " (" << kindName(asset.kind)
+             << ", decoded in " << asset.decodeMs << " ms off-thread, swapped in "
+             << std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms";
+        if (patched > 0) line << ", " << patched << " entities patched";
+        std::cout << line.str() << ")\n";
+    }
+    return layoutChanged;
+}
+
+const HotReloadStats& HotReloader::getStats() const { return stats; }
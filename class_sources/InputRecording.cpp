@@ -0,0 +1,78 @@
+#include "../class_headers/InputRecording.h"
+#include "../class_headers/KeyValueFile.h"
+#include "../class_headers/GameExceptions.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+void InputRecording::push(const PlayerInput& input) { inputs.push_back(input); }
+
+void InputRecording::clear() { inputs.clear(); }
+
+std::size_t InputRecording::size() const { return inputs.size(); }
+
+PlayerInput InputRecording::at(std::size_t tick) const { return tick < inputs.size() ? inputs[tick] : PlayerInput{}; }
+
+void InputRecording::saveToFile(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw ResourceLoadError("Input recording", path, "could not open file for writing");
+    }
+    file << "# ToonLander input recording, '<ticks> <buttons>' per line at 60 ticks/s\n"
+         << "# buttons: 1 left, 2 right, 4 jump, 8 shoot, 16 drop\n";
+    for (std::size_t begin = 0; begin < inputs.size();) {
+        std::size_t end = begin + 1;
+        while (end < inputs.size() && inputs[end] == inputs[begin]) ++end;
+        file << (end - begin) << ' ' << static_cast<unsigned int>(inputs[begin].buttons) << '\n';
+        begin = end;
+    }
+    if (!file) {
+        throw ResourceLoadError("Input recording", path, "write failed");
+    }
+}
+
+InputRecording InputRecording::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw ResourceLoadError("Input recording", path, "could not open file");
+    }
+    InputRecording recording;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = KeyValueFile::trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        std::istringstream stream(line);
+        std::size_t ticks = 0;
+        unsigned int buttons = 0;
+        if (!(stream >> ticks >> buttons) || !(stream >> std::ws).eof() || ticks == 0 || buttons > 0x1F) {
+            throw ConfigurationError("Expected '<ticks> <buttons>' in " + path + ":" + std::to_string(lineNumber));
+        }
+        recording.inputs.insert(recording.inputs.end(), ticks, PlayerInput{static_cast<std::uint8_t>(buttons)});
+    }
+    if (recording.inputs.empty()) {
+        throw ConfigurationError("Input recording " + path + " is empty");
+    }
+    return recording;
+}
+
+InputRecorder::InputRecorder(std::string path) : path(std::move(path)) {}
+
+void InputRecorder::restart() {
+    recording.clear();
+    accumulator = 0.f;
+}
+
+void InputRecorder::update(float dt, const PlayerInput& input) {
+    for (accumulator += dt; accumulator >= InputRecording::tickSeconds; accumulator -= InputRecording::tickSeconds) {
+        recording.push(input);
+    }
+}
+
+void InputRecorder::save() const {
+    if (recording.size() == 0) return;
+    recording.saveToFile(path);
+    std::cout << "Recorded " << recording.size() << " ticks to " << path << "\n";
+}
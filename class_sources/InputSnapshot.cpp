@@ -0,0 +1,72 @@
+#include "../class_headers/InputSnapshot.h"
+
+bool InputSnapshot::validKey(sf::Keyboard::Key key) {
+    return key >= 0 && static_cast<std::size_t>(key) < keyCount; // Unknown is -1
+}
+
+void InputSnapshot::releaseAll() {
+    keysReleased |= keysDown;
+    keysDown.reset();
+    buttonsDown.reset();
+}
+
+void InputSnapshot::beginTick() {
+    keysPressed.reset();
+    keysReleased.reset();
+    buttonsPressed.reset();
+}
+
+void InputSnapshot::handleEvent(const sf::Event& event) {
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+            if (validKey(event.key.code) && !keysDown.test(event.key.code)) { // OS key repeat is not a new press
+                keysDown.set(event.key.code);
+                keysPressed.set(event.key.code);
+                keyPressTime[event.key.code] = Clock::now();
+            }
+            break;
+        case sf::Event::KeyReleased:
+            if (validKey(event.key.code)) {
+                keysDown.reset(event.key.code);
+                keysReleased.set(event.key.code);
+            }
+            break;
+        case sf::Event::MouseButtonPressed:
+            if (event.mouseButton.button < sf::Mouse::ButtonCount) {
+                buttonsDown.set(event.mouseButton.button);
+                buttonsPressed.set(event.mouseButton.button);
+            }
+            mousePosition = {event.mouseButton.x, event.mouseButton.y};
+            break;
+        case sf::Event::MouseButtonReleased:
+            if (event.mouseButton.button < sf::Mouse::ButtonCount) buttonsDown.reset(event.mouseButton.button);
+            mousePosition = {event.mouseButton.x, event.mouseButton.y};
+            break;
+        case sf::Event::MouseMoved:
+            mousePosition = {event.mouseMove.x, event.mouseMove.y};
+            break;
+        case sf::Event::LostFocus:
+            releaseAll();
+            break;
+        default:
+            break;
+    }
+}
+
+bool InputSnapshot::isDown(sf::Keyboard::Key key) const { return validKey(key) && keysDown.test(key); }
+
+bool InputSnapshot::wasPressed(sf::Keyboard::Key key) const { return validKey(key) && keysPressed.test(key); }
+
+bool InputSnapshot::wasReleased(sf::Keyboard::Key key) const { return validKey(key) && keysReleased.test(key); }
+
+bool InputSnapshot::isActive(sf::Keyboard::Key key) const { return isDown(key) || wasPressed(key); }
+
+InputSnapshot::Clock::time_point InputSnapshot::getPressTime(sf::Keyboard::Key key) const {
+    return validKey(key) ? keyPressTime[key] : Clock::time_point{};
+}
+
+bool InputSnapshot::isButtonDown(sf::Mouse::Button button) const { return button < sf::Mouse::ButtonCount && buttonsDown.test(button); }
+
+bool InputSnapshot::wasButtonPressed(sf::Mouse::Button button) const { return button < sf::Mouse::ButtonCount && buttonsPressed.test(button); }
+
+sf::Vector2i InputSnapshot::getMousePosition() const { return mousePosition; }
@@ -0,0 +1,139 @@
+#include "../class_headers/JobSystem.h"
+#include <algorithm>
+
+thread_local std::size_t JobSystem::workerIndex = 0;
+
+JobSystem::JobSystem(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    queues.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; ++i) { // calling thread acts as worker 0
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+std::size_t JobSystem::chunkCount(std::size_t count, std::size_t grainSize) {
+    grainSize = std::max<std::size_t>(1, grainSize);
+    return (count + grainSize - 1) / grainSize;
+}
+
+std::size_t JobSystem::getThreadCount() const { return queues.size(); }
+
+std::size_t JobSystem::currentWorkerIndex() { return workerIndex; }
+
+bool JobSystem::popOwn(std::size_t index, Job& job) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.head == queue.jobs.size()) return false;
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    if (queue.head == queue.jobs.size()) {
+        queue.jobs.clear();
+        queue.head = 0;
+    }
+    return true;
+}
+
+bool JobSystem::steal(std::size_t thiefIndex, Job& job) {
+    const std::size_t queueCount = queues.size();
+    for (std::size_t offset = 1; offset < queueCount; ++offset) { // start at the neighbour to spread contention
+        WorkerQueue& victim = *queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard lock(victim.mutex);
+        if (victim.head == victim.jobs.size()) continue;
+        job = victim.jobs[victim.head++];
+        if (victim.head == victim.jobs.size()) {
+            victim.jobs.clear();
+            victim.head = 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::runJob(const Job& job) {
+    AllocationScope allocationScope(job.allocationTag, job.allocationFree);
+    try {
+        (*job.body)(job.chunkIndex, job.begin, job.end);
+    } catch (...) {
+        std::lock_guard lock(errorMutex);
+        if (!firstError) firstError = std::current_exception();
+    }
+    remainingJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::workerLoop(std::size_t index) {
+    workerIndex = index;
+    std::size_t seenBatches = 0;
+    while (true) {
+        Job job{};
+        if (popOwn(index, job) || steal(index, job)) {
+            runJob(job);
+            continue;
+        }
+        std::unique_lock lock(wakeMutex);
+        wakeCondition.wait(lock, [&] { return stopping || submittedBatches != seenBatches; });
+        if (stopping) return;
+        seenBatches = submittedBatches;
+    }
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grainSize, const RangeFunction& body) {
+    if (count == 0) return;
+    grainSize = std::max<std::size_t>(1, grainSize);
+    const std::size_t chunks = chunkCount(count, grainSize);
+
+    // one chunk, no workers or a nested call from a job: run inline, same chunk layout as the parallel path
+    if (chunks == 1 || workers.empty() || workerIndex != 0) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            body(chunk, chunk * grainSize, std::min(count, (chunk + 1) * grainSize));
+        }
+        return;
+    }
+
+    const AllocationTag allocationTag = AllocationScope::currentTag();
+    const bool allocationFree = AllocationScope::currentIsAllocationFree();
+    remainingJobs.store(chunks, std::memory_order_release);
+    firstError = nullptr;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) { // round-robin so every worker starts with local work
+        WorkerQueue& queue = *queues[chunk % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back({&body, chunk, chunk * grainSize, std::min(count, (chunk + 1) * grainSize), allocationTag, allocationFree});
+    }
+    {
+        std::lock_guard lock(wakeMutex);
+        ++submittedBatches;
+    }
+    wakeCondition.notify_all();
+
+    // the caller works too, then steals until every chunk is done
+    while (remainingJobs.load(std::memory_order_acquire) > 0) {
+        Job job{};
+        if (popOwn(0, job) || steal(0, job)) {
+            runJob(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (firstError) {
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
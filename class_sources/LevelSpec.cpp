@@ -0,0 +1,49 @@
+#include "../class_headers/LevelSpec.h"
+#include "../class_headers/World.h"
+#include "../class_headers/KeyValueFile.h"
+#include <sstream>
+
+LevelSpec LevelSpec::defaultLevel(const sf::Vector2u& windowSize) {
+    LevelSpec level;
+    level.platforms = {{600.f, 700.f, 300.f, 20.f}, {700.f, 500.f, 400.f, 20.f}, {300.f, 350.f, 250.f, 20.f}};
+    level.playerStart = {200.f, World::playerGroundY()};
+
+    const float orcY = World::berserkOrcGroundY();
+    level.berserkOrcs = {{500.f, orcY}, {1200.f, orcY}};
+    level.mageOrcs = {{static_cast<float>(windowSize.x) - 150.f, static_cast<float>(windowSize.y) / 2.5f}};
+    return level;
+}
+
+LevelSpec LevelSpec::loadFromFile(const std::string& path) {
+    LevelSpec level;
+    level.playerStart = {200.f, World::playerGroundY()};
+    KeyValueFile::forEachEntry(path, "Level", [&](const std::string& key, const std::string& value, int lineNumber) {
+        std::vector<float> numbers;
+        std::istringstream stream(value);
+        for (float number; stream >> number;) numbers.push_back(number);
+        auto expect = [&](std::size_t minCount, std::size_t maxCount) {
+            if (!stream.eof() || numbers.size() < minCount || numbers.size() > maxCount) {
+                throw ConfigurationError("Invalid value '" + value + "' for '" + key + "' in " + path + ":" + std::to_string(lineNumber));
+            }
+        };
+        if (key == "platform") {
+            expect(4, 4);
+            if (numbers[2] <= 0.f || numbers[3] <= 0.f) {
+                throw ConfigurationError("Platform without area in " + path + ":" + std::to_string(lineNumber));
+            }
+            level.platforms.emplace_back(numbers[0], numbers[1], numbers[2], numbers[3]);
+        } else if (key == "player") {
+            expect(1, 2);
+            level.playerStart = {numbers[0], numbers.size() > 1 ? numbers[1] : World::playerGroundY()};
+        } else if (key == "berserk_orc") {
+            expect(1, 2);
+            level.berserkOrcs.emplace_back(numbers[0], numbers.size() > 1 ? numbers[1] : World::berserkOrcGroundY());
+        } else if (key == "mage_orc") {
+            expect(2, 2);
+            level.mageOrcs.emplace_back(numbers[0], numbers[1]);
+        } else {
+            throw ConfigurationError("Unknown key '" + key + "' in " + path + ":" + std::to_string(lineNumber));
+        }
+    });
+    return level;
+}
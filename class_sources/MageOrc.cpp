@@ -1,15 +1,14 @@
 #include "../class_headers/MageOrc.h"
 #include "../class_headers/Entity.h"       // Should be included via MageOrc.h
 #include "../class_headers/GameExceptions.h" // For ResourceLoadError, InvalidStateError etc.
+#include "../class_headers/RenderSnapshot.h"
 #include <SFML/Graphics.hpp> // Should be included via MageOrc.h
 #include <string>
 #include <vector>
 #include <iostream>
 #include <random>
-#include <chrono>
-#include <cmath>     // For M_PI, std::sin, std::cos, std::atan2, std::sqrt, std::abs
-
-#define M_PI 3.14
+#include <cmath>     // For std::sin, std::atan2
+#include <numbers>
 
 // helper for linear interpolation
 float lerp(float a, float b, float t) {
@@ -25,7 +24,7 @@ MageOrc::MageOrc(sf::RenderWindow* win, const sf::Vector2f &startPos) :
     idleFrequencyY(0.6f),
     currentCenterY(startPos.y),
     timeSinceLastAction(0.f),
-    rng(static_cast<unsigned long>(std::chrono::steady_clock::now().time_since_epoch().count()))
+    rng(GameRng::seedFrom(startPos.x, startPos.y, SimClock::getNow())) // deterministic, peers must agree
 {
     this->frameWidth = 96;
     this->frameHeight = 96;
@@ -88,7 +87,6 @@ void MageOrc::chooseNextState() {
 
     actionTimer.restart();
     timeSinceLastAction = 0.f;
-    projectilesToSpawn.clear();
 
     // Define animation parameters here for clarity
     const int idleFrames = 4;    float idleInterval = 0.2f;
@@ -111,18 +109,34 @@ void MageOrc::chooseNextState() {
         float targetFlyCenterY = static_cast<float>(window->getSize().y) / 2.f + std::uniform_real_distribution<float>(-flyAmplitudeY * 0.3f, flyAmplitudeY * 0.3f)(rng);
         currentCenterY = targetFlyCenterY;
         currentStateDuration = std::uniform_real_distribution<float>(4.f, 6.f)(rng);
-    } else if (choice <= 6) { // BARRAGE
+    } else if (choice <= 5) { // BARRAGE
         currentState = State::BARRAGE_PREPARE;
         setAnimation("barrage", barrageFrames, barrageInterval);
         velocity = {0, 0};
         currentCenterY = getPosition().y;
         currentStateDuration = 1.0f; // duration of BARRAGE_PREPARE state
-    } else { // FLURRY
+        patternEmitter.setPattern(BulletPatterns::barrageRing);
+    } else if (choice <= 7) { // FLURRY
         currentState = State::FLURRY;
         setAnimation("flurry", flurryFrames, flurryInterval);
         velocity = {0, 0};
         currentCenterY = getPosition().y;
         currentStateDuration = std::uniform_real_distribution<float>(3.0f, 5.0f)(rng);
+        patternEmitter.setPattern(BulletPatterns::flurryShot);
+    } else if (choice <= 9) { // SPIRAL
+        currentState = State::SPIRAL;
+        setAnimation("barrage", barrageFrames, barrageInterval);
+        velocity = {0, 0};
+        currentCenterY = getPosition().y;
+        currentStateDuration = std::uniform_real_distribution<float>(2.5f, 4.0f)(rng);
+        patternEmitter.setPattern(BulletPatterns::spiral);
+    } else { // WAVE
+        currentState = State::WAVE;
+        setAnimation("flurry", flurryFrames, flurryInterval);
+        velocity = {0, 0};
+        currentCenterY = getPosition().y;
+        currentStateDuration = std::uniform_real_distribution<float>(3.0f, 4.5f)(rng);
+        patternEmitter.setPattern(BulletPatterns::wave);
     }
     stateTimer.restart();
 }
@@ -130,48 +144,31 @@ void MageOrc::chooseNextState() {
 void MageOrc::updateSinusoidalMovement(float centerY, float amplitude, float frequency) {
     if (!isAlive) return;
     float timeForSine = actionTimer.getElapsedTime().asSeconds();
-    float verticalOffset = amplitude * std::sin(timeForSine * frequency * 2.0f * M_PI);
+    float verticalOffset = amplitude * std::sin(timeForSine * frequency * 2.0f * std::numbers::pi_v<float>);
     float newY = centerY + verticalOffset;
     setPosition(getPosition().x, newY);
 }
 
-sf::Vector2f MageOrc::calculateVagueAimDirection() {
-    if (!isAlive) return (sprite.getScale().x < 0.0f) ? sf::Vector2f(-1.0f, 0.0f) : sf::Vector2f(1.0f, 0.0f);
-
-    if (!playerPositionPtr) {
-        return (sprite.getScale().x < 0.0f) ? sf::Vector2f(-1.0f, 0.0f) : sf::Vector2f(1.0f, 0.0f);
-    }
-
-    sf::Vector2f magePos = getPosition();
-    sf::Vector2f playerPosVal = *playerPositionPtr; // dereference player pointer
-    sf::Vector2f exactDir = playerPosVal - magePos;
+float MageOrc::calculateAimAngle() const {
+    const float facingAngle = (sprite.getScale().x < 0.0f) ? std::numbers::pi_v<float> : 0.0f;
+    if (!isAlive || !targetPosition) return facingAngle;
 
+    sf::Vector2f exactDir = *targetPosition - getPosition();
     float magSq = exactDir.x * exactDir.x + exactDir.y * exactDir.y;
     constexpr float epsilonSq = 0.1f * 0.1f;
+    if (magSq < epsilonSq) return facingAngle;
 
-    if (magSq < epsilonSq) {
-        return (sprite.getScale().x < 0.0f) ? sf::Vector2f(-1.0f, 0.0f) : sf::Vector2f(1.0f, 0.0f);
-    }
+    return std::atan2(exactDir.y, exactDir.x);
+}
 
-    float exactAngle = std::atan2(exactDir.y, exactDir.x);
+float MageOrc::calculateVagueAimAngle() {
     std::uniform_real_distribution<float> varianceDist(-flurryAimVariance, flurryAimVariance);
-    float variedAngle = exactAngle + varianceDist(rng); // 'randomness' of bullet generation
-
-    return {std::cos(variedAngle), std::sin(variedAngle)};
+    return calculateAimAngle() + varianceDist(rng); // 'randomness' of bullet generation
 }
 
 void MageOrc::prepareBarrage() { // projectile barrage logic
     if (!isAlive) return;
-    projectilesToSpawn.clear();
-    sf::Vector2f centerPos = getPosition();
-    for (int i = 0; i < barrageCount; ++i) {
-        float angle = (static_cast<float>(i) / static_cast<float>(barrageCount)) * 2.0f * M_PI;
-        float spawnRadius = 30.f;
-        float spawnX = centerPos.x + spawnRadius * std::cos(angle);
-        float spawnY = centerPos.y + spawnRadius * std::sin(angle);
-        sf::Vector2f direction(std::cos(angle), std::sin(angle));
-        projectilesToSpawn.push_back({{spawnX, spawnY}, direction, barrageProjectileSpeed});
-    }
+    patternEmitter.fireVolley(getPosition(), 0.f, [this](const SpawnCommand& command) { emitSpawn(command); });
 }
 
 void MageOrc::fireBarrage() {
@@ -181,18 +178,18 @@ void MageOrc::fireBarrage() {
 
 void MageOrc::fireFlurryShot(float dt) {
     if (!isAlive) return;
-    timeSinceLastAction += dt;
-    if (timeSinceLastAction >= flurryShotInterval) {
-        timeSinceLastAction = 0.f;
-        sf::Vector2f spawnPos = getPosition();
-        float horizontalOffset = 40.f;
-        spawnPos.x += (sprite.getScale().x > 0 ? horizontalOffset : -horizontalOffset);
-        sf::Vector2f direction = calculateVagueAimDirection();
-        projectilesToSpawn.push_back({spawnPos, direction, flurryProjectileSpeed});
-    }
+    sf::Vector2f spawnPos = getPosition();
+    spawnPos.x += (sprite.getScale().x > 0 ? flurryHorizontalOffset : -flurryHorizontalOffset);
+    patternEmitter.update(dt, spawnPos, calculateVagueAimAngle(),
+                          [this](const SpawnCommand& command) { emitSpawn(command); });
+}
+
+void MageOrc::firePattern(float dt) {
+    if (!isAlive) return;
+    patternEmitter.update(dt, getPosition(), calculateAimAngle(),
+                          [this](const SpawnCommand& command) { emitSpawn(command); });
 }
 
-void MageOrc::actions() {}
 void MageOrc::update() {}
 
 void MageOrc::updater(float dt) {
@@ -236,6 +233,11 @@ void MageOrc::updater(float dt) {
             fireFlurryShot(dt);
             updateSinusoidalMovement(currentCenterY, idleAmplitudeY * 0.7f, idleFrequencyY * 1.2f);
             break;
+        case State::SPIRAL:
+        case State::WAVE:
+            firePattern(dt);
+            updateSinusoidalMovement(currentCenterY, 10.f, 0.2f);
+            break;
     }
 
     if (currentState != State::BARRAGE_FIRE && currentState != State::BARRAGE_PREPARE) {
@@ -246,15 +248,41 @@ void MageOrc::updater(float dt) {
     Entity::update();
 }
 
-void MageOrc::draw() {
-    if (window) {
-        window->draw(sprite);
-        if (isAlive) {
-            sf::FloatRect globalBounds = getCollisionBounds();
-            hitboxShape.setPosition(globalBounds.left, globalBounds.top);
-            hitboxShape.setSize({globalBounds.width, globalBounds.height});
-            window->draw(hitboxShape);
-        }
+void MageOrc::stepMovement() { // the bobbing of the current state, no timers and no shots
+    switch (currentState) {
+        case State::IDLE:
+            updateSinusoidalMovement(currentCenterY, idleAmplitudeY, idleFrequencyY);
+            break;
+        case State::FLYING:
+            updateSinusoidalMovement(currentCenterY, flyAmplitudeY, flyFrequencyY);
+            break;
+        case State::FLURRY:
+            updateSinusoidalMovement(currentCenterY, idleAmplitudeY * 0.7f, idleFrequencyY * 1.2f);
+            break;
+        case State::BARRAGE_PREPARE:
+        case State::SPIRAL:
+        case State::WAVE:
+            updateSinusoidalMovement(currentCenterY, 10.f, 0.2f);
+            break;
+        case State::BARRAGE_FIRE:
+            break;
+    }
+}
+
+void MageOrc::draw(sf::RenderTarget& target) {
+    target.draw(sprite);
+    if (isAlive) {
+        sf::FloatRect globalBounds = getCollisionBounds();
+        hitboxShape.setPosition(globalBounds.left, globalBounds.top);
+        hitboxShape.setSize({globalBounds.width, globalBounds.height});
+        target.draw(hitboxShape);
+    }
+}
+
+void MageOrc::appendRenderItems(RenderSnapshot& out) const {
+    out.addSprite(sprite);
+    if (isAlive) {
+        out.addRectangle(getCollisionBounds(), hitboxShape.getFillColor(), hitboxShape.getOutlineColor(), hitboxShape.getOutlineThickness());
     }
 }
 
@@ -272,7 +300,6 @@ void MageOrc::takeDamage() {
         currentState = State::IDLE; // Or a State::DEAD
         currentStateDuration = 9999.f;
         stateTimer.restart();
-        projectilesToSpawn.clear();
     }
 }
 
@@ -287,16 +314,47 @@ bool MageOrc::isMarkedForRemoval() const {
     return markedForRemoval;
 }
 
-std::vector<MagicProjectileSpawnInfo> MageOrc::getProjectilesToSpawn() {
-    std::vector<MagicProjectileSpawnInfo> queueToReturn = std::move(projectilesToSpawn);
-    projectilesToSpawn.clear();
-    return queueToReturn;
-}
+void MageOrc::setTarget(EntityHandle target) { targetHandle = target; }
+
+EntityHandle MageOrc::getTarget() const { return targetHandle; }
 
-void MageOrc::updatePlayerPosition(sf::Vector2f* playerPos) {
-    playerPositionPtr = playerPos;
+void MageOrc::updateTargetPosition(const std::optional<sf::Vector2f>& position) {
+    targetPosition = position;
 }
 
 sf::FloatRect MageOrc::getCollisionBounds() const {
     return sprite.getTransform().transformRect(customHitbox);
+}
+
+void MageOrc::saveState(SnapshotWriter& writer) const {
+    Entity::saveState(writer);
+    writer.write(currentState);
+    writer.write(currentCenterY);
+    writer.write(stateTimer);
+    writer.write(currentStateDuration);
+    writer.write(actionTimer);
+    writer.write(timeSinceLastAction);
+    writer.write(rng);
+    writer.write(patternEmitter);
+    writer.write(targetPosition.has_value());
+    writer.write(targetPosition.value_or(sf::Vector2f{}));
+    writer.write(markedForRemoval);
+    writer.write(isAlive);
+}
+
+void MageOrc::loadState(SnapshotReader& reader) {
+    Entity::loadState(reader);
+    currentState = reader.read<State>();
+    currentCenterY = reader.read<float>();
+    stateTimer = reader.read<SimClock>();
+    currentStateDuration = reader.read<float>();
+    actionTimer = reader.read<SimClock>();
+    timeSinceLastAction = reader.read<float>();
+    rng = reader.read<GameRng>();
+    patternEmitter = reader.read<PatternEmitter>();
+    const bool hasTarget = reader.read<bool>();
+    const auto position = reader.read<sf::Vector2f>();
+    targetPosition = hasTarget ? std::optional(position) : std::nullopt;
+    markedForRemoval = reader.read<bool>();
+    isAlive = reader.read<bool>();
 }
\ No newline at end of file
@@ -15,17 +15,8 @@ MagicProjectile::MagicProjectile(sf::RenderWindow *win, float x, float y, float
     try {
         loadAnimationTexture("mage_projectile", "assets/projectiles/mage_projectile.png");
         setAnimation("mage_projectile", 8, 0.15f);
-
-        float magnitude = std::sqrt(dx * dx + dy * dy);
-        if (magnitude > 0) {
-            velocity = sf::Vector2f((dx / magnitude) * speed, (dy / magnitude) * speed);
-        } else {
-            velocity = sf::Vector2f(speed, 0.0f);
-            std::cerr << "Warning: MagicProjectile created with zero direction vector." << std::endl;
-        }
-
         setScale(1.5f, 1.5f);
-        setPosition(x, y);
+        reset(x, y, dx, dy, projectileSpeed);
 
     } catch (const ResourceLoadError& e) {
         std::cerr << "ERROR creating MagicProjectile (ResourceLoadError): " << e.what() << std::endl;
@@ -42,12 +33,30 @@ void MagicProjectile::update() {
     Entity::update(); // call base function
 }
 
-void MagicProjectile::draw() { if (window && sprite.getTexture() != nullptr) { window->draw(this->sprite); } }
+void MagicProjectile::draw(sf::RenderTarget& target) { if (sprite.getTexture() != nullptr) { target.draw(this->sprite); } }
 
 void MagicProjectile::markForRemoval() { markedForRemoval = true; }
 
 bool MagicProjectile::isMarkedForRemoval() const { return markedForRemoval; }
 
+void MagicProjectile::applyIntegratedPosition(float x, float y) {
+    sprite.setPosition(x, y);
+    Entity::update();
+}
+
+void MagicProjectile::reset(float x, float y, float dx, float dy, float projectileSpeed) {
+    speed = projectileSpeed;
+    markedForRemoval = false;
+    float magnitude = std::sqrt(dx * dx + dy * dy);
+    if (magnitude > 0) {
+        velocity = sf::Vector2f((dx / magnitude) * speed, (dy / magnitude) * speed);
+    } else {
+        velocity = sf::Vector2f(speed, 0.0f);
+        std::cerr << "Warning: MagicProjectile created with zero direction vector." << std::endl;
+    }
+    setPosition(x, y);
+}
+
 void MagicProjectile::checkOffScreen() {
     if (window && !markedForRemoval) {
         sf::Vector2u windowSize = window->getSize();
@@ -60,6 +69,4 @@ void MagicProjectile::checkOffScreen() {
     }
 }
 
-void MagicProjectile::actions() {}
-
 void MagicProjectile::takeDamage() { markForRemoval(); }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "../class_headers/GameExceptions.h"
 #include "../class_headers/Menu.h"
+#include "../class_headers/RenderSnapshot.h"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <string>
@@ -9,9 +10,9 @@ void Menu::centerOrigin(sf::Text& text) {
     text.setOrigin(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
 }
 
-void Menu::loadBackground() {
-    if (!backgroundTexture.loadFromFile("assets/backgrounds/bg_menu.png")) {
-        throw ResourceLoadError("Background", "assets/backgrounds/bg_menu.png", "Failed to load background image for menu.");
+void Menu::loadBackground(const sf::Image& image) {
+    if (!backgroundTexture.loadFromImage(image)) {
+        throw ResourceLoadError("Background", backgroundPath, "Failed to upload background image for menu.");
     }
 
     bgSpr1.setTexture(backgroundTexture);
@@ -31,14 +32,10 @@ void Menu::loadBackground() {
 
 }
 
-Menu::Menu(sf::RenderWindow* win) : window(win) {
+Menu::Menu(sf::RenderWindow* win, const sf::Font& font, const sf::Image& background) : window(win), font(font) {
     if (!window) { throw GameLogicError("Menu requires a valid RenderWindow pointer!"); }
     try {
-        loadBackground();
-
-        if (!font.loadFromFile("assets/ARCADECLASSIC.TTF")) {
-            throw ResourceLoadError("Font", "assets/ARCADECLASSIC.TTF", "Failed to load menu font.");
-        }
+        loadBackground(background);
 
         title.setFont(font);
         title.setString("TOONLANDER");
@@ -79,20 +76,30 @@ Menu::Menu(sf::RenderWindow* win) : window(win) {
     }
 }
 
-void Menu::draw() const { // draw all elements on screen
-    window->draw(bgSpr1);
-    window->draw(bgSpr2);
-    window->draw(title);
-    window->draw(buttonBox);
-    window->draw(startButtonText);
+void Menu::draw(sf::RenderTarget& target) const { // draw all elements on screen
+    target.draw(bgSpr1);
+    target.draw(bgSpr2);
+    target.draw(title);
+    target.draw(buttonBox);
+    target.draw(startButtonText);
 }
 
-void Menu::handleInput(const sf::Event& event) {
-    sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(*window));
-
-    isHovering = buttonBox.getGlobalBounds().contains(mousePos);
+void Menu::appendRenderItems(RenderSnapshot& out) const {
+    out.setLayer(RenderLayer::UI);
+    out.addSprite(bgSpr1);
+    out.addSprite(bgSpr2);
+    out.addText(title);
+    out.addRectangle(buttonBox);
+    out.addText(startButtonText);
+}
 
+void Menu::handleInput(const sf::Event& event) {
+    // hover follows the event coordinates, no per-event cursor query to the window system
+    if (event.type == sf::Event::MouseMoved) {
+        isHovering = buttonBox.getGlobalBounds().contains(static_cast<float>(event.mouseMove.x), static_cast<float>(event.mouseMove.y));
+    }
     if (event.type == sf::Event::MouseButtonPressed) {
+        isHovering = buttonBox.getGlobalBounds().contains(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y));
         if (event.mouseButton.button == sf::Mouse::Left) {
             if (isHovering) { // if button is clicked
                 startRequested = true;
@@ -130,4 +137,6 @@ void Menu::update(float dt) {
     }
 }
 
-bool Menu::isStartRequested() const { return startRequested; }
\ No newline at end of file
+bool Menu::isStartRequested() const { return startRequested; }
+
+void Menu::clearStartRequest() { startRequested = false; }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "../class_headers/NavGraph.h"
+#include "../class_headers/Platform.h"
+#include "../class_headers/GameExceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace {
+    constexpr float jumpHeightMargin{0.9f}; // don't plan jumps that need a perfect apex
+    constexpr float dropPenalty{20.f};
+    constexpr float jumpPenalty{60.f}; // walking around is preferred over hopping
+    constexpr std::int32_t notSearched{-3};
+}
+
+float JumpPhysics::maxJumpHeight() const {
+    return gravity > 0.f ? jumpSpeed * jumpSpeed / (2.f * gravity) : 0.f;
+}
+
+std::optional<float> JumpPhysics::airTicks(float launchVy, float rise) const {
+    // launchVy * t + gravity * t^2 / 2 = -rise, the later root is the way down
+    if (gravity <= 0.f) return std::nullopt;
+    const float discriminant = launchVy * launchVy - 2.f * gravity * rise;
+    if (discriminant < 0.f) return std::nullopt;
+    const float ticks = (-launchVy + std::sqrt(discriminant)) / gravity;
+    if (ticks <= 0.f) return std::nullopt;
+    return ticks;
+}
+
+sf::Vector2f NavLink::feetAt(float tick) const {
+    const float t = std::clamp(tick, 0.f, airTicks);
+    if (t >= airTicks) return {landingX, toY}; // exact landing, no rounding left on the arc
+    const float progress = airTicks > 0.f ? t / airTicks : 1.f;
+    return {takeoffX + (landingX - takeoffX) * progress, fromY + launchVy * t + 0.5f * gravity * t * t};
+}
+
+void NavGraph::clear() {
+    spans.clear();
+    links.clear();
+    firstLink.clear();
+    nextLinkCache.clear();
+    stats = {};
+}
+
+void NavGraph::build(std::span<const Platform> platforms, float groundY, float worldWidth, const JumpPhysics& physics, float agentHalfWidth) {
+    if (worldWidth <= 0.f || physics.gravity <= 0.f || physics.runSpeed <= 0.f) {
+        throw ConfigurationError("NavGraph needs a positive world width, gravity and run speed");
+    }
+    clear();
+    spans.push_back({0.f, worldWidth, groundY});
+    for (const Platform& platform : platforms) {
+        const sf::FloatRect bounds = platform.getBounds();
+        if (bounds.top >= groundY || bounds.width <= 0.f) continue; // nothing to stand on above the ground
+        spans.push_back({bounds.left, bounds.left + bounds.width, bounds.top});
+    }
+
+    for (std::size_t from = 0; from < spans.size(); ++from) {
+        addLinksFrom(static_cast<std::int32_t>(from), physics, agentHalfWidth, worldWidth);
+    }
+    std::stable_sort(links.begin(), links.end(), [](const NavLink& a, const NavLink& b) {
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+    firstLink.assign(spans.size() + 1, 0);
+    for (const NavLink& link : links) ++firstLink[static_cast<std::size_t>(link.from) + 1];
+    for (std::size_t s = 0; s < spans.size(); ++s) firstLink[s + 1] += firstLink[s];
+
+    nextLinkCache.resize(spans.size());
+    stats.spans = spans.size();
+    stats.links = links.size();
+}
+
+void NavGraph::addLinksFrom(std::int32_t from, const JumpPhysics& physics, float agentHalfWidth, float worldWidth) {
+    const NavSpan& source = spans[static_cast<std::size_t>(from)];
+    const float reachableRise = physics.maxJumpHeight() * jumpHeightMargin;
+
+    auto addLink = [&](std::int32_t to, NavLinkKind kind, float takeoffX, float landingX, float launchVy) {
+        const NavSpan& target = spans[static_cast<std::size_t>(to)];
+        const std::optional<float> ticks = physics.airTicks(launchVy, source.y - target.y);
+        if (!ticks) return false;
+        const float horizontal = std::abs(landingX - takeoffX);
+        if (horizontal > physics.runSpeed * *ticks) return false; // can't cover the gap before coming down
+        const float penalty = kind == NavLinkKind::JUMP ? jumpPenalty : dropPenalty;
+        links.push_back({from, to, kind, takeoffX, landingX, source.y, target.y, launchVy, physics.gravity, *ticks,
+                         horizontal + std::abs(source.y - target.y) + penalty});
+        return true;
+    };
+
+    // drops: walk off either edge and fall onto the first span below
+    if (from != 0) {
+        for (const float side : {-1.f, 1.f}) {
+            const float edgeX = side < 0.f ? source.left : source.right;
+            const float landingX = edgeX + side * (agentHalfWidth + 1.f);
+            if (landingX < 0.f || landingX > worldWidth) continue;
+            const std::optional<std::int32_t> below = spanBelow({landingX, source.y + 1.f}, 0.f);
+            if (below) addLink(*below, NavLinkKind::DROP, edgeX, landingX, 0.f);
+        }
+    }
+
+    // jumps: straight up through a one-way platform overhead, or across a gap from the nearer edge
+    for (std::size_t t = 1; t < spans.size(); ++t) { // never jump down to the ground, dropping gets there
+        const auto to = static_cast<std::int32_t>(t);
+        if (to == from) continue;
+        const NavSpan& target = spans[t];
+        const float rise = source.y - target.y;
+        if (rise > reachableRise) continue;
+
+        const float overlapLeft = std::max(source.left, target.left) + agentHalfWidth;
+        const float overlapRight = std::min(source.right, target.right) - agentHalfWidth;
+        if (target.right < source.left || target.left > source.right) {
+            const bool towardsRight = target.left > source.right;
+            const float takeoffX = towardsRight ? source.right : source.left;
+            const float inset = std::min(0.5f * agentHalfWidth, 0.5f * (target.right - target.left)); // half the body over the edge is enough
+            const float landingX = towardsRight ? target.left + inset : target.right - inset;
+            addLink(to, NavLinkKind::JUMP, takeoffX, landingX, -physics.jumpSpeed);
+        } else if (rise > 0.f && overlapLeft <= overlapRight) {
+            const float x = 0.5f * (overlapLeft + overlapRight);
+            addLink(to, NavLinkKind::JUMP, x, x, -physics.jumpSpeed);
+        }
+    }
+}
+
+std::optional<std::int32_t> NavGraph::spanBelow(const sf::Vector2f& feet, float tolerance) const {
+    std::optional<std::int32_t> best;
+    for (std::size_t s = 0; s < spans.size(); ++s) {
+        const NavSpan& span = spans[s];
+        if (feet.x < span.left || feet.x > span.right || span.y < feet.y - tolerance) continue;
+        if (!best || span.y < spans[static_cast<std::size_t>(*best)].y) best = static_cast<std::int32_t>(s);
+    }
+    return best;
+}
+
+std::int32_t NavGraph::nextLink(std::int32_t start, std::int32_t goal, std::pmr::memory_resource* scratch) const {
+    if (start < 0 || goal < 0 || static_cast<std::size_t>(start) >= spans.size() || static_cast<std::size_t>(goal) >= spans.size()) {
+        throw GameLogicError("NavGraph query for span " + std::to_string(start) + " -> " + std::to_string(goal) +
+                             " outside a graph of " + std::to_string(spans.size()));
+    }
+    if (start == goal) return sameSpan;
+
+    std::vector<std::int32_t>& column = nextLinkCache[static_cast<std::size_t>(goal)];
+    if (column.empty()) column.assign(spans.size(), notSearched);
+    std::int32_t& cached = column[static_cast<std::size_t>(start)];
+    if (cached != notSearched) {
+        ++stats.cacheHits;
+        return cached;
+    }
+    cached = search(start, goal, scratch);
+    ++stats.searches;
+    return cached;
+}
+
+std::int32_t NavGraph::search(std::int32_t start, std::int32_t goal, std::pmr::memory_resource* scratch) const {
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    const std::size_t count = spans.size();
+    const NavSpan& goalSpan = spans[static_cast<std::size_t>(goal)];
+
+    // walking plus the links' own distances never beat the straight horizontal gap plus the height difference
+    auto heuristic = [&](std::size_t span, float x) {
+        const float outside = x < goalSpan.left ? goalSpan.left - x : (x > goalSpan.right ? x - goalSpan.right : 0.f);
+        return outside + std::abs(spans[span].y - goalSpan.y);
+    };
+
+    std::pmr::vector<float> cost(count, infinity, scratch);
+    std::pmr::vector<float> entryX(count, 0.f, scratch); // where the best path so far arrives on each span
+    std::pmr::vector<std::int32_t> arrivedBy(count, -1, scratch);
+    std::pmr::vector<std::uint8_t> closed(count, 0, scratch);
+    using OpenEntry = std::pair<float, std::int32_t>; // f, span; ties go to the lower index so every peer agrees
+    std::pmr::vector<OpenEntry> open(scratch);
+
+    const auto startIndex = static_cast<std::size_t>(start);
+    cost[startIndex] = 0.f;
+    entryX[startIndex] = 0.5f * (spans[startIndex].left + spans[startIndex].right); // canonical start keeps results cacheable
+    open.emplace_back(heuristic(startIndex, entryX[startIndex]), start);
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<>{});
+        const auto span = static_cast<std::size_t>(open.back().second);
+        open.pop_back();
+        if (closed[span]) continue;
+        closed[span] = 1;
+        if (span == static_cast<std::size_t>(goal)) break;
+
+        for (std::uint32_t l = firstLink[span]; l < firstLink[span + 1]; ++l) {
+            const NavLink& link = links[l];
+            const auto to = static_cast<std::size_t>(link.to);
+            if (closed[to]) continue;
+            const float candidate = cost[span] + std::abs(entryX[span] - link.takeoffX) + link.cost;
+            if (candidate >= cost[to]) continue;
+            cost[to] = candidate;
+            entryX[to] = link.landingX;
+            arrivedBy[to] = static_cast<std::int32_t>(l);
+            open.emplace_back(candidate + heuristic(to, link.landingX), link.to);
+            std::push_heap(open.begin(), open.end(), std::greater<>{});
+        }
+    }
+
+    if (arrivedBy[static_cast<std::size_t>(goal)] < 0) return unreachable;
+    std::int32_t link = arrivedBy[static_cast<std::size_t>(goal)];
+    while (links[static_cast<std::size_t>(link)].from != start) { // walk back to the first hop
+        link = arrivedBy[static_cast<std::size_t>(links[static_cast<std::size_t>(link)].from)];
+    }
+    return link;
+}
+
+const NavSpan& NavGraph::getSpan(std::int32_t index) const { return spans.at(static_cast<std::size_t>(index)); }
+
+const NavLink& NavGraph::getLink(std::int32_t index) const { return links.at(static_cast<std::size_t>(index)); }
+
+std::size_t NavGraph::getSpanCount() const { return spans.size(); }
+
+const NavGraphStats& NavGraph::getStats() const { return stats; }
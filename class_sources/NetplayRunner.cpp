@@ -0,0 +1,145 @@
+#include "../class_headers/NetplayRunner.h"
+#include "../class_headers/World.h"
+#include "../class_headers/LevelSpec.h"
+#include "../class_headers/ConcreteEntityFactory.h"
+#include "../class_headers/EventBus.h"
+#include "../class_headers/GameRng.h"
+#include "../class_headers/InputSnapshot.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+NetplayRunner::NetplayRunner(NetplayOptions options) : options(std::move(options)) {}
+
+void NetplayRunner::printStats(const RollbackStats& stats, const UdpLink& link) {
+    const double meanDepth = stats.rollbacks > 0 ? static_cast<double>(stats.rolledBackTicks) / static_cast<double>(stats.rollbacks) : 0.0;
+    std::cout << std::fixed << std::setprecision(3)
+              << "--- netplay report ---\n"
+              << "ticks:              " << stats.ticks << "\n"
+              << "rollbacks:          " << stats.rollbacks << "\n"
+              << "rollback depth:     " << meanDepth << " mean, " << stats.maxRollbackDepth << " max\n"
+              << "resimulation ms:    " << stats.resimulationSeconds * 1000.0 << " total\n"
+              << "stalled ticks:      " << stats.stalledTicks << "\n"
+              << "packets sent:       " << link.getPacketsSent() << " (" << link.getPacketsDropped() << " dropped)\n"
+              << "checksums compared: " << stats.checksumsCompared << "\n"
+              << "desyncs:            " << stats.desyncs;
+    if (stats.firstDesyncTick >= 0) std::cout << " (first at tick " << stats.firstDesyncTick << ")";
+    std::cout << std::endl;
+}
+
+int NetplayRunner::run() const {
+    sf::RenderWindow window(sf::VideoMode({windowWidth, windowHeight}),
+                            "ToonLander netplay: player " + std::to_string(options.rollback.localSlot + 1), sf::Style::Default);
+    window.setVisible(!options.headless);
+    window.setVerticalSyncEnabled(false); // paced below at the simulation rate
+
+    EventBus eventBus; // no sound in netplay yet, events are dropped
+    World world(&window, std::make_unique<ConcreteEntityFactory>(), &eventBus);
+    world.enableCoop();
+    world.reset(LevelSpec::defaultLevel(window.getSize())); // both peers start from the same state and clock
+    world.setPlayerInvulnerable(options.bot); // bots would die quickly and end the soak run
+
+    UdpLink link(options.localPort, options.peerAddress, options.peerPort, options.conditions);
+    RollbackSession session(world, &eventBus, link, options.rollback);
+    GameRng botRng(static_cast<std::uint64_t>(options.rollback.localSlot) + 1);
+    PlayerInput botInput;
+    InputSnapshot inputSnapshot;
+
+    using Clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(RollbackSession::tickSeconds));
+    auto nextTick = Clock::now();
+    auto lastProgress = nextTick;
+    int exitCode = 0;
+
+    while (window.isOpen() && (options.ticks == 0 || session.getCurrentTick() < options.ticks)) {
+        world.getFrameArena().reset(); // a rollback re-simulates several ticks on this frame's arena
+        inputSnapshot.beginTick();
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            inputSnapshot.handleEvent(event);
+            if (event.type == sf::Event::Closed) window.close();
+        }
+
+        PlayerInput input;
+        if (options.bot) {
+            if (botRng() % 20 == 0) botInput.buttons = static_cast<std::uint8_t>(botRng() & 0x1F); // hold each choice a while
+            input = botInput;
+        } else {
+            input = PlayerInput::fromSnapshot(inputSnapshot); // focus loss releases every key
+        }
+
+        if (session.advance(input)) {
+            lastProgress = Clock::now();
+        } else if (Clock::now() - lastProgress > std::chrono::duration<float>(stallTimeoutSeconds)) {
+            std::cerr << "Peer stopped responding at tick " << session.getCurrentTick() << std::endl;
+            exitCode = 4;
+            break;
+        }
+        eventBus.discardPending();
+
+        window.clear();
+        world.draw();
+        window.display();
+
+        nextTick += tickDuration;
+        if (nextTick < Clock::now()) nextTick = Clock::now(); // fell behind, do not try to catch up in a burst
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    // the peer may still be missing our last inputs or a checksum, keep the link alive briefly
+    const auto lingerEnd = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(lingerSeconds));
+    while (exitCode == 0 && Clock::now() < lingerEnd) {
+        session.pollNetwork();
+        std::this_thread::sleep_for(tickDuration);
+    }
+
+    printStats(session.getStats(), link);
+    if (exitCode == 0 && session.getStats().desyncs > 0) exitCode = 3;
+    return exitCode;
+}
+
+int NetplayRunner::runFromCommandLine(const std::vector<std::string>& args) {
+    auto valueOf = [&args](const std::string& flag) -> const std::string* {
+        auto it = std::ranges::find(args, flag);
+        return it != args.end() && std::next(it) != args.end() ? &*std::next(it) : nullptr;
+    };
+    try {
+        NetplayOptions options;
+        const std::string* slot = valueOf("--slot");
+        const std::string* port = valueOf("--port");
+        const std::string* peer = valueOf("--peer");
+        if (!slot || !port || !peer || peer->find(':') == std::string::npos) {
+            std::cerr << "usage: --netplay --slot <0|1> --port <local port> --peer <host:port> [--delay <ticks>] "
+                         "[--rollback <ticks>] [--latency <ms>] [--jitter <ms>] [--loss <0..1>] [--ticks <n>] [--bot] [--headless]"
+                      << std::endl;
+            return 2;
+        }
+        options.rollback.localSlot = std::stoi(*slot);
+        options.localPort = static_cast<unsigned short>(std::stoul(*port));
+        const std::size_t colon = peer->rfind(':');
+        options.peerAddress = peer->substr(0, colon);
+        options.peerPort = static_cast<unsigned short>(std::stoul(peer->substr(colon + 1)));
+        if (const std::string* value = valueOf("--delay")) options.rollback.inputDelay = static_cast<std::uint32_t>(std::stoul(*value));
+        if (const std::string* value = valueOf("--rollback")) options.rollback.maxRollback = static_cast<std::uint32_t>(std::stoul(*value));
+        if (const std::string* value = valueOf("--latency")) options.conditions.latencyMs = std::stof(*value);
+        if (const std::string* value = valueOf("--jitter")) options.conditions.jitterMs = std::stof(*value);
+        if (const std::string* value = valueOf("--loss")) options.conditions.lossRate = std::stof(*value);
+        if (const std::string* value = valueOf("--ticks")) options.ticks = static_cast<std::uint32_t>(std::stoul(*value));
+        options.bot = std::ranges::find(args, "--bot") != args.end();
+        options.headless = std::ranges::find(args, "--headless") != args.end();
+
+        NetplayRunner runner(std::move(options));
+        return runner.run();
+    } catch (const GameError& e) {
+        std::cerr << "\n--- NETPLAY FAILED ---\n" << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) { // std::stoi and friends on malformed numbers
+        std::cerr << "\n--- STANDARD EXCEPTION CAUGHT ---\n" << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,209 @@
+#include "../class_headers/ParticleSystem.h"
+#include "../class_headers/EventBus.h"
+#include "../class_headers/RenderSnapshot.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PARTICLE_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_KERNELS_SSE2
+#endif
+
+namespace {
+    enum PoolIndex : std::size_t { SPARKS, DEBRIS };
+    constexpr unsigned int sparkTextureSize{16};
+}
+
+ParticlePool::ParticlePool(std::size_t capacity, const sf::Texture* texture, const sf::BlendMode& blendMode) :
+    x(capacity), y(capacity), vx(capacity), vy(capacity), gravity(capacity), age(capacity), lifetime(capacity),
+    halfSize(capacity), color(capacity), texture(texture), blendMode(blendMode) {}
+
+ParticleSystem::ParticleSystem(EventBus* bus, std::size_t capacity, std::size_t initialBudget) :
+    eventBus(bus),
+    muzzleFlash{SPARKS, 10, 60.f, 220.f, 0.06f, 0.14f, 3.f, 0.f, sf::Color(255, 230, 150)},
+    hitSparks{SPARKS, 24, 120.f, 420.f, 0.15f, 0.35f, 2.5f, 900.f, sf::Color(255, 170, 60)},
+    deathDebris{DEBRIS, 120, 60.f, 320.f, 0.5f, 1.0f, 4.f, 700.f, sf::Color(150, 40, 40)},
+    budget(0) {
+    if (capacity == 0) throw ConfigurationError("ParticleSystem capacity must be at least 1");
+
+    sf::Image dot; // radial falloff, white so the vertex colour tints it
+    dot.create(sparkTextureSize, sparkTextureSize, sf::Color::Transparent);
+    const float centre = (static_cast<float>(sparkTextureSize) - 1.f) / 2.f;
+    for (unsigned int py = 0; py < sparkTextureSize; ++py) {
+        for (unsigned int px = 0; px < sparkTextureSize; ++px) {
+            const float distance = std::hypot(static_cast<float>(px) - centre, static_cast<float>(py) - centre) / (centre + 0.5f);
+            const float falloff = std::clamp(1.f - distance, 0.f, 1.f);
+            dot.setPixel(px, py, sf::Color(255, 255, 255, static_cast<sf::Uint8>(falloff * falloff * 255.f)));
+        }
+    }
+    if (!sparkTexture.loadFromImage(dot)) {
+        throw ResourceLoadError("Texture", "generated:particle_spark", "Failed to create the particle texture.");
+    }
+    sparkTexture.setSmooth(true);
+
+    pools.reserve(2);
+    pools.emplace_back(capacity, &sparkTexture, sf::BlendAdd); // SPARKS, glow where they overlap
+    pools.emplace_back(capacity, nullptr, sf::BlendAlpha); // DEBRIS
+    setBudget(initialBudget);
+
+    if (eventBus) {
+        eventBus->subscribe(this, EventBus::maskOf(GameEvent::PLAYER_FIRED) | EventBus::maskOf(GameEvent::PROJECTILE_HIT) |
+                                  EventBus::maskOf(GameEvent::ENEMY_DIED));
+    }
+}
+
+ParticleSystem::~ParticleSystem() {
+    if (eventBus) eventBus->unsubscribe(this);
+}
+
+void ParticleSystem::onNotify(const GameEventData& event) {
+    switch (event.type) {
+        case GameEvent::PLAYER_FIRED:
+            emit(muzzleFlash, event.position);
+            break;
+        case GameEvent::PROJECTILE_HIT:
+            emit(hitSparks, event.position);
+            break;
+        case GameEvent::ENEMY_DIED:
+            emit(deathDebris, event.position);
+            break;
+        default:
+            break;
+    }
+}
+
+void ParticleSystem::emit(const ParticleEmitter& emitter, const sf::Vector2f& position) {
+    ParticlePool& pool = pools[emitter.pool];
+    const auto wanted = static_cast<std::size_t>(std::max(emitter.count, 0));
+    const std::size_t room = std::min(budget - std::min(budget, stats.live), pool.capacity() - pool.count);
+    const std::size_t spawned = std::min(wanted, room);
+    stats.dropped += wanted - spawned;
+
+    std::uniform_real_distribution angleDist(0.f, 2.f * std::numbers::pi_v<float>);
+    std::uniform_real_distribution speedDist(emitter.minSpeed, emitter.maxSpeed);
+    std::uniform_real_distribution lifetimeDist(emitter.minLifetime, emitter.maxLifetime);
+    for (std::size_t n = 0; n < spawned; ++n) {
+        const std::size_t i = pool.count++;
+        const float angle = angleDist(rng);
+        const float speed = speedDist(rng);
+        pool.x[i] = position.x;
+        pool.y[i] = position.y;
+        pool.vx[i] = std::cos(angle) * speed;
+        pool.vy[i] = std::sin(angle) * speed;
+        pool.gravity[i] = emitter.gravity;
+        pool.age[i] = 0.f;
+        pool.lifetime[i] = lifetimeDist(rng);
+        pool.halfSize[i] = emitter.halfSize;
+        pool.color[i] = emitter.color;
+    }
+    stats.live += spawned;
+    stats.peak = std::max(stats.peak, stats.live);
+}
+
+void ParticleSystem::removeExpired(ParticlePool& pool) {
+    for (std::size_t i = 0; i < pool.count;) { // swap-remove, draw order within a pool does not matter
+        if (pool.age[i] < pool.lifetime[i]) {
+            ++i;
+            continue;
+        }
+        const std::size_t last = --pool.count;
+        pool.x[i] = pool.x[last]; pool.y[i] = pool.y[last];
+        pool.vx[i] = pool.vx[last]; pool.vy[i] = pool.vy[last];
+        pool.gravity[i] = pool.gravity[last];
+        pool.age[i] = pool.age[last]; pool.lifetime[i] = pool.lifetime[last];
+        pool.halfSize[i] = pool.halfSize[last];
+        pool.color[i] = pool.color[last];
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    if (dt <= 0.f) return; // paused
+    stats.live = 0;
+    for (ParticlePool& pool : pools) {
+        integrate(pool.x.data(), pool.y.data(), pool.vx.data(), pool.vy.data(), pool.gravity.data(), pool.age.data(), pool.count, dt);
+        removeExpired(pool);
+        stats.live += pool.count;
+    }
+}
+
+void ParticleSystem::clear() {
+    for (ParticlePool& pool : pools) pool.count = 0;
+    stats.live = 0;
+}
+
+void ParticleSystem::appendRenderItems(RenderSnapshot& out) const {
+    out.setLayer(RenderLayer::PARTICLES);
+    for (const ParticlePool& pool : pools) {
+        if (pool.count == 0) continue;
+        const sf::Vector2f textureSize = pool.texture ? sf::Vector2f(pool.texture->getSize()) : sf::Vector2f(0.f, 0.f);
+        const std::span<sf::Vertex> quads = out.addVertices(pool.count * 4, sf::Quads, pool.texture, pool.blendMode);
+        for (std::size_t i = 0; i < pool.count; ++i) {
+            const float h = pool.halfSize[i];
+            const float fade = 1.f - std::min(pool.age[i] / pool.lifetime[i], 1.f);
+            sf::Color color = pool.color[i];
+            color.a = static_cast<sf::Uint8>(fade * 255.f);
+            sf::Vertex* quad = &quads[i * 4];
+            quad[0] = sf::Vertex({pool.x[i] - h, pool.y[i] - h}, color, {0.f, 0.f});
+            quad[1] = sf::Vertex({pool.x[i] + h, pool.y[i] - h}, color, {textureSize.x, 0.f});
+            quad[2] = sf::Vertex({pool.x[i] + h, pool.y[i] + h}, color, textureSize);
+            quad[3] = sf::Vertex({pool.x[i] - h, pool.y[i] + h}, color, {0.f, textureSize.y});
+        }
+    }
+}
+
+void ParticleSystem::setBudget(std::size_t value) {
+    std::size_t totalCapacity = 0;
+    for (const ParticlePool& pool : pools) totalCapacity += pool.capacity();
+    budget = std::min(value, totalCapacity);
+    for (auto pool = pools.rbegin(); pool != pools.rend() && stats.live > budget; ++pool) { // debris goes first
+        const std::size_t excess = std::min(stats.live - budget, pool->count);
+        pool->count -= excess;
+        stats.live -= excess;
+    }
+}
+
+std::size_t ParticleSystem::getBudget() const { return budget; }
+
+const ParticleStats& ParticleSystem::getStats() const { return stats; }
+
+void ParticleSystem::integrateScalar(float* x, float* y, const float* vx, float* vy, const float* gravity, float* age,
+                                     std::size_t count, float dt) {
+    for (std::size_t i = 0; i < count; ++i) {
+        vy[i] += gravity[i] * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        age[i] += dt;
+    }
+}
+
+void ParticleSystem::integrate(float* x, float* y, const float* vx, float* vy, const float* gravity, float* age,
+                               std::size_t count, float dt) {
+    std::size_t i = 0;
+#if defined(PARTICLE_KERNELS_AVX2)
+    const __m256 step = _mm256_set1_ps(dt);
+    for (; i + 8 <= count; i += 8) {
+        const __m256 newVy = _mm256_add_ps(_mm256_loadu_ps(vy + i), _mm256_mul_ps(_mm256_loadu_ps(gravity + i), step));
+        _mm256_storeu_ps(vy + i, newVy);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), step)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(newVy, step)));
+        _mm256_storeu_ps(age + i, _mm256_add_ps(_mm256_loadu_ps(age + i), step));
+    }
+#elif defined(PARTICLE_KERNELS_SSE2)
+    const __m128 step = _mm_set1_ps(dt);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 newVy = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_loadu_ps(gravity + i), step));
+        _mm_storeu_ps(vy + i, newVy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), step)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(newVy, step)));
+        _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), step));
+    }
+#endif
+    integrateScalar(x + i, y + i, vx + i, vy + i, gravity + i, age + i, count - i, dt); // tail
+}
@@ -1,5 +1,7 @@
 #include "../class_headers/Platform.h"
+#include "../class_headers/RenderSnapshot.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 
 // platform constructor only positioning and size needed
 Platform::Platform(float x, float y, float width, float height) {
@@ -9,7 +11,23 @@ Platform::Platform(float x, float y, float width, float height) {
 }
 
 // platform draw function
-void Platform::draw(sf::RenderWindow& win) const { win.draw(shape); }
+void Platform::draw(sf::RenderTarget& target) const { target.draw(shape); }
+
+void Platform::appendRenderItems(RenderSnapshot& out) const { out.addRectangle(shape); }
 
 // getter for collisions
-sf::FloatRect Platform::getBounds() const { return shape.getGlobalBounds(); }
\ No newline at end of file
+sf::FloatRect Platform::getBounds() const { return shape.getGlobalBounds(); }
+
+std::optional<float> Platform::landingTime(const sf::FloatRect& box, const sf::Vector2f& displacement, float tolerance) const {
+    constexpr float edgeInset = 1.0f; // hanging over an edge by less than this does not count
+    const sf::FloatRect bounds = getBounds();
+    const float startBottom = box.top + box.height;
+    const float endBottom = startBottom + displacement.y;
+    if (displacement.y < 0.f || startBottom > bounds.top + tolerance || endBottom < bounds.top) return std::nullopt;
+
+    // time of impact of the bottom edge, then horizontal overlap where the box is at that moment
+    const float time = displacement.y > 0.f ? std::clamp((bounds.top - startBottom) / displacement.y, 0.f, 1.f) : 0.f;
+    const float left = box.left + displacement.x * time;
+    if (left + box.width <= bounds.left + edgeInset || left >= bounds.left + bounds.width - edgeInset) return std::nullopt;
+    return time;
+}
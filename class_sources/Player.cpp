@@ -2,6 +2,7 @@
 #include "../class_headers/Entity.h"
 #include "../class_headers/Platform.h"
 #include "../class_headers/GameExceptions.h"
+#include "../class_headers/RenderSnapshot.h"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <string>
@@ -34,17 +35,18 @@ Player::Player(sf::RenderWindow* win,
                const std::string& initialTexturePath,
                int initialNumFrames,
                float initialAnimationInterval,
-               const sf::Vector2f& startPosition)
+               const sf::Vector2f& startPosition,
+               bool singletonInstance)
     : Entity(win) {
     // prevent multiple instantiations
-    if (instanceExists) { throw std::runtime_error("Player singleton already constructed. Do not call constructor directly."); }
+    if (singletonInstance && instanceExists) { throw std::runtime_error("Player singleton already constructed. Do not call constructor directly."); }
 
     if (!win) { throw GameLogicError("Player constructor called with nullptr window (should be via getInstance)."); }
 
     try {
         this->frameWidth = 128;
         this->frameHeight = 128;
-        this->healthPoints = 3;
+        this->healthPoints = maxHealthPoints;
 
         // load base and state-specific animations
         loadAnimationTexture(initialAnimationName, initialTexturePath);
@@ -72,61 +74,71 @@ Player::Player(sf::RenderWindow* win,
         hitboxShape_debug.setOutlineColor(sf::Color::Green);
         hitboxShape_debug.setOutlineThickness(1.0f);
 
-        instanceExists = true; // construction successful
+        if (singletonInstance) instanceExists = true; // construction successful
 
     } catch (const ResourceLoadError& e) {
         std::cerr << "FATAL ERROR during Player construction (ResourceLoadError): " << e.what() << std::endl;
-        instanceExists = false; // failed construction
+        if (singletonInstance) instanceExists = false; // failed construction
         throw GameError("Failed to initialize Player resources due to loading error.");
     } catch (const InvalidStateError& e) {
         std::cerr << "FATAL ERROR during Player construction (InvalidStateError): " << e.what() << std::endl;
-        instanceExists = false;
+        if (singletonInstance) instanceExists = false;
         throw GameError("Failed to configure Player state during initialization.");
     } catch (const GameError& e) {
         std::cerr << "FATAL ERROR during Player construction (GameError): " << e.what() << std::endl;
-        instanceExists = false;
+        if (singletonInstance) instanceExists = false;
         throw;
     } catch (const std::exception& e) {
         std::cerr << "FATAL std::exception during Player construction: " << e.what() << std::endl;
-        instanceExists = false;
+        if (singletonInstance) instanceExists = false;
         throw GameError("Standard exception during Player initialization.");
     } catch (...) {
         std::cerr << "FATAL unknown exception during Player construction." << std::endl;
-        instanceExists = false;
+        if (singletonInstance) instanceExists = false;
         throw GameError("Unknown exception during Player initialization.");
     }
 }
 
+std::unique_ptr<Player> Player::createCoopPartner(sf::RenderWindow* win, const sf::Vector2f& startPosition, std::pmr::memory_resource* resource) {
+    // private constructor, so no make_unique
+    return std::unique_ptr<Player>(new (resource) Player(win, "idle", "assets/player/Idle.png", 6, 0.1f, startPosition, false));
+}
+
 // transforms hitbox to world space
 sf::FloatRect Player::getHitboxGlobalBounds() const { return sprite.getTransform().transformRect(customHitbox_local); }
 
 sf::FloatRect Player::getCollisionBounds() const { return getHitboxGlobalBounds(); }
 
-void Player::draw() {
-    if (window) {
-        window->draw(this->sprite);
+void Player::draw(sf::RenderTarget& target) {
+    target.draw(this->sprite);
 
-        // update and draw debug hitbox
-        sf::FloatRect globalHitbox = getHitboxGlobalBounds();
-        hitboxShape_debug.setPosition(globalHitbox.left, globalHitbox.top);
-        hitboxShape_debug.setSize({globalHitbox.width, globalHitbox.height});
-        window->draw(hitboxShape_debug);
-    }
+    // update and draw debug hitbox
+    sf::FloatRect globalHitbox = getHitboxGlobalBounds();
+    hitboxShape_debug.setPosition(globalHitbox.left, globalHitbox.top);
+    hitboxShape_debug.setSize({globalHitbox.width, globalHitbox.height});
+    target.draw(hitboxShape_debug);
+}
+
+void Player::appendRenderItems(RenderSnapshot& out) const {
+    out.addSprite(sprite);
+    out.addRectangle(getHitboxGlobalBounds(), hitboxShape_debug.getFillColor(), hitboxShape_debug.getOutlineColor(),
+                     hitboxShape_debug.getOutlineThickness());
 }
 
-void Player::actions() {
+void Player::applyInput(const PlayerInput& input) {
     // skip input if player is dead
     if (healthPoints <= 0) {
         velocity.x = 0;
         return;
     }
 
-    wantsToShootFlag = false;
-    bool tryingToShoot = sf::Keyboard::isKeyPressed(sf::Keyboard::X);
+    bool tryingToShoot = input.has(PlayerInput::SHOOT);
 
     // handle shooting input
     if (tryingToShoot && currentShootCooldown <= 0 && onGround && velocity.x == 0 && !isJumping && !isShooting) {
-        wantsToShootFlag = true;
+        ProjectileSpawnInfo spawnInfo = getProjectileSpawnDetails();
+        emitSpawn({SpawnKind::PLAYER_PROJECTILE, spawnInfo.position, spawnInfo.direction, spawnInfo.speed});
+        notifyObservers(GameEvent::PLAYER_FIRED, spawnInfo.position, static_cast<int>(handle.index));
         setAnimation("shoot", 4, 0.09f);
         isShooting = true;
         currentShootCooldown = shootCooldownFrames;
@@ -136,8 +148,8 @@ void Player::actions() {
 
     if (!isShooting) {
         // handle movement input
-        bool movingLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
-        bool movingRight = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+        bool movingLeft = input.has(PlayerInput::LEFT);
+        bool movingRight = input.has(PlayerInput::RIGHT);
 
         if (movingLeft) {
             velocity.x = -moveSpeed;
@@ -160,7 +172,7 @@ void Player::actions() {
         }
 
         // handle jump input
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Z)) {
+        if (input.has(PlayerInput::JUMP)) {
             if (canJump && onGround) {
                 jump();
             }
@@ -169,7 +181,7 @@ void Player::actions() {
         }
 
         // handle drop input
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::C) && onGround && !isJumping) {
+        if (input.has(PlayerInput::DROP) && onGround && !isJumping) {
             isDropping = true;
             onGround = false;
             velocity.y = dropThroughSpeed;
@@ -180,7 +192,7 @@ void Player::actions() {
 void Player::jump() {
     // activate jump state and notify
     setAnimation("jump", 10, 0.05f);
-    notifyObservers(GameEvent::PLAYER_JUMPED);
+    notifyObservers(GameEvent::PLAYER_JUMPED, getPosition(), static_cast<int>(handle.index));
     velocity.y = jumpStrength;
     isJumping = true;
     onGround = false;
@@ -192,7 +204,7 @@ void Player::update() {
     Entity::update();
 }
 
-void Player::updater(const std::vector<Platform>& platforms) {
+void Player::updater(std::span<const Platform> platforms) {
     // if dead, apply gravity and align to ground
     if (healthPoints <= 0) {
         if (!onGround) velocity.y += gravityForce;
@@ -223,15 +235,45 @@ void Player::updater(const std::vector<Platform>& platforms) {
 
     if (!onGround) velocity.y += gravityForce;
 
-    sprite.move(isShooting ? 0.f : velocity.x, velocity.y);
+    const sf::FloatRect hitboxBeforeMove = getHitboxGlobalBounds();
+    const sf::Vector2f displacement(isShooting ? 0.f : velocity.x, velocity.y);
+    sprite.move(displacement);
 
     onGround = false;
+    // platform landing, swept over the whole step so a fall faster than a platform is thick cannot pass through it;
+    // the earliest top reached wins when the step crosses several, and any platform comes before the ground below it
+    if (velocity.y >= 0 && !isDropping) {
+        const float landingTolerance = velocity.y > 0 ? velocity.y : 5.0f; // how deep the last step may have sunk in
+        const Platform* landedOn = nullptr;
+        float earliestLanding = 2.f;
+        for (const auto& platform : platforms) {
+            const std::optional<float> landing = platform.landingTime(hitboxBeforeMove, displacement, landingTolerance);
+            if (landing && *landing < earliestLanding) {
+                earliestLanding = *landing;
+                landedOn = &platform;
+            }
+        }
+
+        if (landedOn) {
+            float hitboxBottomFromOriginY = (customHitbox_local.top + customHitbox_local.height) - (static_cast<float>(frameHeight) / 2.f);
+            float targetY = landedOn->getBounds().top - hitboxBottomFromOriginY * this->currentScaleY;
+            setPosition(getPosition().x, targetY);
+            velocity.y = 0;
+            isJumping = false;
+            onGround = true;
+            isDropping = false;
+            if (!isShooting && velocity.x == 0 && currentAnimationName != "idle") {
+                setAnimation("idle", 6, 0.1f);
+            }
+        }
+    }
+
     sf::FloatRect playerHitbox = getHitboxGlobalBounds();
     sf::Vector2f currentPlayerPos = getPosition();
     float playerBottomY = playerHitbox.top + playerHitbox.height;
 
     // check for ground collision
-    if (playerBottomY >= defaultGroundY && velocity.y >= 0) {
+    if (!onGround && playerBottomY >= defaultGroundY && velocity.y >= 0) {
         float hitboxBottomOffsetFromOrigin = (customHitbox_local.top + customHitbox_local.height) - (static_cast<float>(frameHeight) / 2.f);
         float targetY = defaultGroundY - hitboxBottomOffsetFromOrigin * currentScaleY;
         setPosition(currentPlayerPos.x, targetY);
@@ -244,38 +286,6 @@ void Player::updater(const std::vector<Platform>& platforms) {
         }
     }
 
-    // platform collision handling
-    for (const auto& platform : platforms) {
-        if (onGround) break;
-
-        sf::FloatRect platformBounds = platform.getBounds();
-        playerHitbox = getHitboxGlobalBounds();
-
-        if (playerHitbox.intersects(platformBounds)) {
-            float previousPlayerBottom = playerHitbox.top + playerHitbox.height - velocity.y;
-
-            if (velocity.y >= 0 && !isDropping &&
-                previousPlayerBottom <= platformBounds.top + (velocity.y > 0 ? velocity.y : 5.0f) &&
-                (playerHitbox.top + playerHitbox.height) >= platformBounds.top) {
-                if ((playerHitbox.left + playerHitbox.width > platformBounds.left + 1.0f) &&
-                    (playerHitbox.left < platformBounds.left + platformBounds.width - 1.0f)) {
-
-                    float hitboxBottomFromOriginY = (customHitbox_local.top + customHitbox_local.height) - (static_cast<float>(frameHeight) / 2.f);
-                    float targetY = platformBounds.top - hitboxBottomFromOriginY * this->currentScaleY;
-                    setPosition(getPosition().x, targetY);
-                    velocity.y = 0;
-                    isJumping = false;
-                    onGround = true;
-                    isDropping = false;
-                    if (!isShooting && velocity.x == 0 && currentAnimationName != "idle") {
-                        setAnimation("idle", 6, 0.1f);
-                    }
-                    break;
-                }
-            }
-        }
-    }
-
     // determine current animation state
     if (onGround && !isJumping && !isShooting) {
         if (velocity.x != 0 && currentAnimationName != "run") {
@@ -286,12 +296,7 @@ void Player::updater(const std::vector<Platform>& platforms) {
     }
 }
 
-// check if player wants to shoot this frame
-bool Player::wantsToShootProjectile() const {
-    return wantsToShootFlag;
-}
-
-ProjectileSpawnInfo Player::getProjectileSpawnDetails() {
+ProjectileSpawnInfo Player::getProjectileSpawnDetails() const {
     // calculate spawn position from hitbox and direction
     sf::Vector2f spawnPos = getPosition();
     float horizontalOffset = (customHitbox_local.width / 2.f + 10.f) * currentScaleX;
@@ -302,16 +307,15 @@ ProjectileSpawnInfo Player::getProjectileSpawnDetails() {
     spawnPos.y += (hitboxCenterY_local - spriteOriginY_local) * currentScaleY;
 
     sf::Vector2f direction = facingRight ? sf::Vector2f(1.f, 0.f) : sf::Vector2f(-1.f, 0.f);
-    wantsToShootFlag = false;
     return {spawnPos, direction, projectileMoveSpeed};
 }
 
 void Player::takeDamage() {
-    if (healthPoints <= 0) return;
+    if (healthPoints <= 0 || invulnerable) return;
 
     // decrement health and notify
     healthPoints--;
-    notifyObservers(GameEvent::PLAYER_TOOK_DAMAGE);
+    notifyObservers(GameEvent::PLAYER_TOOK_DAMAGE, getPosition(), static_cast<int>(handle.index));
     std::cout << "Player took damage. HP: " << healthPoints << std::endl;
 
     if (healthPoints <= 0) {
@@ -320,4 +324,50 @@ void Player::takeDamage() {
     } else {
         setAnimation("hurt", 5, 0.1f);
     }
-}
\ No newline at end of file
+}
+
+void Player::setInvulnerable(bool value) {
+    invulnerable = value;
+}
+
+JumpPhysics Player::jumpPhysics() {
+    return {moveSpeed, -jumpStrength, gravityForce};
+}
+
+void Player::reset(const sf::Vector2f& startPosition) {
+    healthPoints = maxHealthPoints;
+    velocity = {0.f, 0.f};
+    isJumping = false;
+    canJump = true;
+    onGround = false;
+    isDropping = false;
+    currentShootCooldown = 0;
+    facingRight = true;
+    isShooting = false;
+
+    setPosition(startPosition);
+    sprite.setScale(this->currentScaleX, this->currentScaleY); // face right again
+    setAnimation("idle", 6, 0.1f);
+}
+
+void Player::saveState(SnapshotWriter& writer) const {
+    Entity::saveState(writer);
+    writer.write(isJumping);
+    writer.write(canJump);
+    writer.write(onGround);
+    writer.write(isDropping);
+    writer.write(currentShootCooldown);
+    writer.write(facingRight);
+    writer.write(isShooting);
+}
+
+void Player::loadState(SnapshotReader& reader) {
+    Entity::loadState(reader);
+    isJumping = reader.read<bool>();
+    canJump = reader.read<bool>();
+    onGround = reader.read<bool>();
+    isDropping = reader.read<bool>();
+    currentShootCooldown = reader.read<int>();
+    facingRight = reader.read<bool>();
+    isShooting = reader.read<bool>();
+}
@@ -0,0 +1,13 @@
+#include "../class_headers/PlayerInput.h"
+#include "../class_headers/InputSnapshot.h"
+
+PlayerInput PlayerInput::fromSnapshot(const InputSnapshot& snapshot) {
+    // isActive keeps a tap that was pressed and released between two ticks
+    PlayerInput input;
+    input.set(LEFT, snapshot.isActive(sf::Keyboard::Left));
+    input.set(RIGHT, snapshot.isActive(sf::Keyboard::Right));
+    input.set(JUMP, snapshot.isActive(sf::Keyboard::Z));
+    input.set(SHOOT, snapshot.isActive(sf::Keyboard::X));
+    input.set(DROP, snapshot.isActive(sf::Keyboard::C));
+    return input;
+}
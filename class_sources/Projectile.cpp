@@ -11,20 +11,23 @@ Projectile::Projectile(sf::RenderWindow* win, float x, float y, float dx, float
 
     loadAnimationTexture("projectile", "assets/projectiles/player_bullet.png");
     setAnimation("projectile", 1, 1.0f);
+    setScale(2.75f, 2.75f);
+    reset(x, y, dx, dy, projectileSpeed);
+}
 
+void Projectile::reset(float x, float y, float dx, float dy, float projectileSpeed) {
+    speed = projectileSpeed;
+    markedForRemoval = false;
     float magnitude = std::sqrt(dx * dx + dy * dy);
     if (magnitude > 0) {
         velocity = sf::Vector2f(dx / magnitude * speed, dy / magnitude * speed);
     } else {
         velocity = sf::Vector2f(speed, 0.0f);
     }
-
-    setScale(2.75f, 2.75f);
     setPosition(x, y);
 }
 
 
-void Projectile::actions() {}
 void Projectile::takeDamage() {}
 
 void Projectile::update() {
@@ -33,9 +36,9 @@ void Projectile::update() {
     Entity::update();
 }
 
-void Projectile::draw() {
-    if (window && sprite.getTexture() != nullptr) {
-        window->draw(this->sprite);
+void Projectile::draw(sf::RenderTarget& target) {
+    if (sprite.getTexture() != nullptr) {
+        target.draw(this->sprite);
     }
 }
 
@@ -43,6 +46,11 @@ void Projectile::markForRemoval() { markedForRemoval = true; }
 
 bool Projectile::isMarkedForRemoval() const { return markedForRemoval; }
 
+void Projectile::applyIntegratedPosition(float x, float y) {
+    sprite.setPosition(x, y);
+    Entity::update();
+}
+
 void Projectile::checkOffScreen() {
     if (window && !markedForRemoval) {
         sf::Vector2u windowSize = window->getSize();
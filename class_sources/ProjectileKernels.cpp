@@ -0,0 +1,354 @@
+#include "../class_headers/ProjectileKernels.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PROJECTILE_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECTILE_KERNELS_SSE2
+#endif
+
+ProjectileArrays::ProjectileArrays(std::pmr::memory_resource* resource) :
+    x(resource), y(resource), vx(resource), vy(resource), halfWidth(resource), halfHeight(resource),
+    offScreen(resource), hits(resource), hitTimes(resource) {}
+
+void ProjectileArrays::reserve(std::size_t count) {
+    x.reserve(count); y.reserve(count);
+    vx.reserve(count); vy.reserve(count);
+    halfWidth.reserve(count); halfHeight.reserve(count);
+    offScreen.reserve(count); hits.reserve(count); hitTimes.reserve(count);
+}
+
+void ProjectileArrays::push(float px, float py, float pvx, float pvy, float hw, float hh) {
+    x.push_back(px); y.push_back(py);
+    vx.push_back(pvx); vy.push_back(pvy);
+    halfWidth.push_back(hw); halfHeight.push_back(hh);
+    offScreen.push_back(0); hits.push_back(0); hitTimes.push_back(0.f);
+}
+
+void ProjectileArrays::clear() {
+    x.clear(); y.clear();
+    vx.clear(); vy.clear();
+    halfWidth.clear(); halfHeight.clear();
+    offScreen.clear(); hits.clear(); hitTimes.clear();
+}
+
+void ProjectileArrays::moveElement(std::size_t from, std::size_t to) {
+    x[to] = x[from]; y[to] = y[from];
+    vx[to] = vx[from]; vy[to] = vy[from];
+    halfWidth[to] = halfWidth[from]; halfHeight[to] = halfHeight[from];
+    offScreen[to] = offScreen[from]; hits[to] = hits[from]; hitTimes[to] = hitTimes[from];
+}
+
+void ProjectileArrays::resize(std::size_t count) {
+    x.resize(count); y.resize(count);
+    vx.resize(count); vy.resize(count);
+    halfWidth.resize(count); halfHeight.resize(count);
+    offScreen.resize(count); hits.resize(count); hitTimes.resize(count);
+}
+
+// scalar reference kernels
+
+void ProjectileKernels::integrateScalar(float* x, float* y, const float* vx, const float* vy, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] += vx[i];
+        y[i] += vy[i];
+    }
+}
+
+void ProjectileKernels::flagOutOfBoundsScalar(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                              std::size_t count, float areaWidth, float areaHeight, std::uint8_t* outFlags) {
+    for (std::size_t i = 0; i < count; ++i) {
+        float left = x[i] - halfWidth[i];
+        float top = y[i] - halfHeight[i];
+        float width = halfWidth[i] + halfWidth[i];
+        float height = halfHeight[i] + halfHeight[i];
+        float buffer = std::max(width, height) * 2.0f;
+        bool out = left + width < -buffer || left > areaWidth + buffer ||
+                   top + height < -buffer || top > areaHeight + buffer;
+        outFlags[i] = out ? 1 : 0;
+    }
+}
+
+void ProjectileKernels::overlapTargetScalar(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                            std::size_t count, const sf::FloatRect& target, std::uint8_t* outFlags) {
+    const float targetRight = target.left + target.width;
+    const float targetBottom = target.top + target.height;
+    for (std::size_t i = 0; i < count; ++i) {
+        float left = std::max(x[i] - halfWidth[i], target.left);
+        float right = std::min(x[i] + halfWidth[i], targetRight);
+        float top = std::max(y[i] - halfHeight[i], target.top);
+        float bottom = std::min(y[i] + halfHeight[i], targetBottom);
+        outFlags[i] = (left < right && top < bottom) ? 1 : 0;
+    }
+}
+
+// slab test of the step's start point against the target grown by the bullet's half extents:
+// the bullet overlaps the target while the point is strictly inside, i.e. between entering and leaving both slabs;
+// the time of impact is the entry, or 0 when the step already started inside
+void ProjectileKernels::sweepTargetScalar(const float* x, const float* y, const float* vx, const float* vy,
+                                          const float* halfWidth, const float* halfHeight,
+                                          std::size_t count, const sf::FloatRect& target, float* outTimes) {
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    const float targetRight = target.left + target.width;
+    const float targetBottom = target.top + target.height;
+    auto slab = [](float start, float velocity, float low, float high, float& enter, float& exit) {
+        if (velocity == 0.f) return low < start && start < high; // parallel, inside for the whole step or never
+        const float a = (low - start) / velocity;
+        const float b = (high - start) / velocity;
+        enter = std::max(enter, std::min(a, b));
+        exit = std::min(exit, std::max(a, b));
+        return true;
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        float enter = -infinity;
+        float exit = infinity;
+        const bool parallelInside =
+            slab(x[i] - vx[i], vx[i], target.left - halfWidth[i], targetRight + halfWidth[i], enter, exit) &&
+            slab(y[i] - vy[i], vy[i], target.top - halfHeight[i], targetBottom + halfHeight[i], enter, exit);
+        outTimes[i] = (parallelInside && enter < exit && enter < 1.f && exit > 0.f) ? std::max(enter, 0.f) : infinity;
+    }
+}
+
+#if defined(PROJECTILE_KERNELS_AVX2)
+
+static void storeMask(int mask, std::size_t lanes, std::uint8_t* out) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) out[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+}
+
+void ProjectileKernels::integrate(float* x, float* y, const float* vx, const float* vy, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(vx + i)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(vy + i)));
+    }
+    integrateScalar(x + i, y + i, vx + i, vy + i, count - i);
+}
+
+void ProjectileKernels::flagOutOfBounds(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                        std::size_t count, float areaWidth, float areaHeight, std::uint8_t* outFlags) {
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 areaW = _mm256_set1_ps(areaWidth);
+    const __m256 areaH = _mm256_set1_ps(areaHeight);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 hw = _mm256_loadu_ps(halfWidth + i);
+        __m256 hh = _mm256_loadu_ps(halfHeight + i);
+        __m256 left = _mm256_sub_ps(_mm256_loadu_ps(x + i), hw);
+        __m256 top = _mm256_sub_ps(_mm256_loadu_ps(y + i), hh);
+        __m256 width = _mm256_add_ps(hw, hw);
+        __m256 height = _mm256_add_ps(hh, hh);
+        __m256 buffer = _mm256_mul_ps(_mm256_max_ps(width, height), two);
+        __m256 negBuffer = _mm256_sub_ps(zero, buffer);
+        __m256 out = _mm256_or_ps(
+            _mm256_or_ps(_mm256_cmp_ps(_mm256_add_ps(left, width), negBuffer, _CMP_LT_OQ),
+                         _mm256_cmp_ps(left, _mm256_add_ps(areaW, buffer), _CMP_GT_OQ)),
+            _mm256_or_ps(_mm256_cmp_ps(_mm256_add_ps(top, height), negBuffer, _CMP_LT_OQ),
+                         _mm256_cmp_ps(top, _mm256_add_ps(areaH, buffer), _CMP_GT_OQ)));
+        storeMask(_mm256_movemask_ps(out), 8, outFlags + i);
+    }
+    flagOutOfBoundsScalar(x + i, y + i, halfWidth + i, halfHeight + i, count - i, areaWidth, areaHeight, outFlags + i);
+}
+
+void ProjectileKernels::overlapTarget(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                      std::size_t count, const sf::FloatRect& target, std::uint8_t* outFlags) {
+    const __m256 targetLeft = _mm256_set1_ps(target.left);
+    const __m256 targetTop = _mm256_set1_ps(target.top);
+    const __m256 targetRight = _mm256_set1_ps(target.left + target.width);
+    const __m256 targetBottom = _mm256_set1_ps(target.top + target.height);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 hw = _mm256_loadu_ps(halfWidth + i);
+        __m256 hh = _mm256_loadu_ps(halfHeight + i);
+        __m256 left = _mm256_max_ps(_mm256_sub_ps(px, hw), targetLeft);
+        __m256 right = _mm256_min_ps(_mm256_add_ps(px, hw), targetRight);
+        __m256 top = _mm256_max_ps(_mm256_sub_ps(py, hh), targetTop);
+        __m256 bottom = _mm256_min_ps(_mm256_add_ps(py, hh), targetBottom);
+        __m256 hit = _mm256_and_ps(_mm256_cmp_ps(left, right, _CMP_LT_OQ), _mm256_cmp_ps(top, bottom, _CMP_LT_OQ));
+        storeMask(_mm256_movemask_ps(hit), 8, outFlags + i);
+    }
+    overlapTargetScalar(x + i, y + i, halfWidth + i, halfHeight + i, count - i, target, outFlags + i);
+}
+
+void ProjectileKernels::sweepTarget(const float* x, const float* y, const float* vx, const float* vy,
+                                    const float* halfWidth, const float* halfHeight,
+                                    std::size_t count, const sf::FloatRect& target, float* outTimes) {
+    const __m256 targetLeft = _mm256_set1_ps(target.left);
+    const __m256 targetTop = _mm256_set1_ps(target.top);
+    const __m256 targetRight = _mm256_set1_ps(target.left + target.width);
+    const __m256 targetBottom = _mm256_set1_ps(target.top + target.height);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 negInfinity = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    // same operations as the scalar slab, lanes with zero velocity take the parallel branch through blends
+    auto slab = [&](__m256 start, __m256 velocity, __m256 low, __m256 high, __m256& enter, __m256& exit) {
+        const __m256 parallel = _mm256_cmp_ps(velocity, zero, _CMP_EQ_OQ);
+        const __m256 a = _mm256_div_ps(_mm256_sub_ps(low, start), velocity);
+        const __m256 b = _mm256_div_ps(_mm256_sub_ps(high, start), velocity);
+        enter = _mm256_max_ps(enter, _mm256_blendv_ps(_mm256_min_ps(a, b), negInfinity, parallel));
+        exit = _mm256_min_ps(exit, _mm256_blendv_ps(_mm256_max_ps(a, b), infinity, parallel));
+        const __m256 inside = _mm256_and_ps(_mm256_cmp_ps(low, start, _CMP_LT_OQ), _mm256_cmp_ps(start, high, _CMP_LT_OQ));
+        return _mm256_or_ps(_mm256_andnot_ps(parallel, _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ)), inside);
+    };
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 hw = _mm256_loadu_ps(halfWidth + i);
+        const __m256 hh = _mm256_loadu_ps(halfHeight + i);
+        const __m256 pvx = _mm256_loadu_ps(vx + i);
+        const __m256 pvy = _mm256_loadu_ps(vy + i);
+        __m256 enter = negInfinity;
+        __m256 exit = infinity;
+        const __m256 validX = slab(_mm256_sub_ps(_mm256_loadu_ps(x + i), pvx), pvx,
+                                   _mm256_sub_ps(targetLeft, hw), _mm256_add_ps(targetRight, hw), enter, exit);
+        const __m256 validY = slab(_mm256_sub_ps(_mm256_loadu_ps(y + i), pvy), pvy,
+                                   _mm256_sub_ps(targetTop, hh), _mm256_add_ps(targetBottom, hh), enter, exit);
+        const __m256 hit = _mm256_and_ps(_mm256_and_ps(validX, validY),
+                                         _mm256_and_ps(_mm256_cmp_ps(enter, exit, _CMP_LT_OQ),
+                                                       _mm256_and_ps(_mm256_cmp_ps(enter, one, _CMP_LT_OQ),
+                                                                     _mm256_cmp_ps(exit, zero, _CMP_GT_OQ))));
+        _mm256_storeu_ps(outTimes + i, _mm256_blendv_ps(infinity, _mm256_max_ps(enter, zero), hit));
+    }
+    sweepTargetScalar(x + i, y + i, vx + i, vy + i, halfWidth + i, halfHeight + i, count - i, target, outTimes + i);
+}
+
+const char* ProjectileKernels::instructionSet() { return "AVX2"; }
+
+#elif defined(PROJECTILE_KERNELS_SSE2)
+
+static void storeMask(int mask, std::size_t lanes, std::uint8_t* out) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) out[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+}
+
+void ProjectileKernels::integrate(float* x, float* y, const float* vx, const float* vy, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(vx + i)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(vy + i)));
+    }
+    integrateScalar(x + i, y + i, vx + i, vy + i, count - i);
+}
+
+void ProjectileKernels::flagOutOfBounds(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                        std::size_t count, float areaWidth, float areaHeight, std::uint8_t* outFlags) {
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 areaW = _mm_set1_ps(areaWidth);
+    const __m128 areaH = _mm_set1_ps(areaHeight);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 hw = _mm_loadu_ps(halfWidth + i);
+        __m128 hh = _mm_loadu_ps(halfHeight + i);
+        __m128 left = _mm_sub_ps(_mm_loadu_ps(x + i), hw);
+        __m128 top = _mm_sub_ps(_mm_loadu_ps(y + i), hh);
+        __m128 width = _mm_add_ps(hw, hw);
+        __m128 height = _mm_add_ps(hh, hh);
+        __m128 buffer = _mm_mul_ps(_mm_max_ps(width, height), two);
+        __m128 negBuffer = _mm_sub_ps(zero, buffer);
+        __m128 out = _mm_or_ps(
+            _mm_or_ps(_mm_cmplt_ps(_mm_add_ps(left, width), negBuffer),
+                      _mm_cmpgt_ps(left, _mm_add_ps(areaW, buffer))),
+            _mm_or_ps(_mm_cmplt_ps(_mm_add_ps(top, height), negBuffer),
+                      _mm_cmpgt_ps(top, _mm_add_ps(areaH, buffer))));
+        storeMask(_mm_movemask_ps(out), 4, outFlags + i);
+    }
+    flagOutOfBoundsScalar(x + i, y + i, halfWidth + i, halfHeight + i, count - i, areaWidth, areaHeight, outFlags + i);
+}
+
+void ProjectileKernels::overlapTarget(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                      std::size_t count, const sf::FloatRect& target, std::uint8_t* outFlags) {
+    const __m128 targetLeft = _mm_set1_ps(target.left);
+    const __m128 targetTop = _mm_set1_ps(target.top);
+    const __m128 targetRight = _mm_set1_ps(target.left + target.width);
+    const __m128 targetBottom = _mm_set1_ps(target.top + target.height);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 hw = _mm_loadu_ps(halfWidth + i);
+        __m128 hh = _mm_loadu_ps(halfHeight + i);
+        __m128 left = _mm_max_ps(_mm_sub_ps(px, hw), targetLeft);
+        __m128 right = _mm_min_ps(_mm_add_ps(px, hw), targetRight);
+        __m128 top = _mm_max_ps(_mm_sub_ps(py, hh), targetTop);
+        __m128 bottom = _mm_min_ps(_mm_add_ps(py, hh), targetBottom);
+        __m128 hit = _mm_and_ps(_mm_cmplt_ps(left, right), _mm_cmplt_ps(top, bottom));
+        storeMask(_mm_movemask_ps(hit), 4, outFlags + i);
+    }
+    overlapTargetScalar(x + i, y + i, halfWidth + i, halfHeight + i, count - i, target, outFlags + i);
+}
+
+void ProjectileKernels::sweepTarget(const float* x, const float* y, const float* vx, const float* vy,
+                                    const float* halfWidth, const float* halfHeight,
+                                    std::size_t count, const sf::FloatRect& target, float* outTimes) {
+    const __m128 targetLeft = _mm_set1_ps(target.left);
+    const __m128 targetTop = _mm_set1_ps(target.top);
+    const __m128 targetRight = _mm_set1_ps(target.left + target.width);
+    const __m128 targetBottom = _mm_set1_ps(target.top + target.height);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 negInfinity = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    auto select = [](__m128 mask, __m128 whenSet, __m128 whenClear) { // no blendv before SSE4.1
+        return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, whenClear));
+    };
+    auto slab = [&](__m128 start, __m128 velocity, __m128 low, __m128 high, __m128& enter, __m128& exit) {
+        const __m128 parallel = _mm_cmpeq_ps(velocity, zero);
+        const __m128 a = _mm_div_ps(_mm_sub_ps(low, start), velocity);
+        const __m128 b = _mm_div_ps(_mm_sub_ps(high, start), velocity);
+        enter = _mm_max_ps(enter, select(parallel, negInfinity, _mm_min_ps(a, b)));
+        exit = _mm_min_ps(exit, select(parallel, infinity, _mm_max_ps(a, b)));
+        const __m128 inside = _mm_and_ps(_mm_cmplt_ps(low, start), _mm_cmplt_ps(start, high));
+        return _mm_or_ps(_mm_andnot_ps(parallel, _mm_cmpeq_ps(zero, zero)), inside);
+    };
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 hw = _mm_loadu_ps(halfWidth + i);
+        const __m128 hh = _mm_loadu_ps(halfHeight + i);
+        const __m128 pvx = _mm_loadu_ps(vx + i);
+        const __m128 pvy = _mm_loadu_ps(vy + i);
+        __m128 enter = negInfinity;
+        __m128 exit = infinity;
+        const __m128 validX = slab(_mm_sub_ps(_mm_loadu_ps(x + i), pvx), pvx,
+                                   _mm_sub_ps(targetLeft, hw), _mm_add_ps(targetRight, hw), enter, exit);
+        const __m128 validY = slab(_mm_sub_ps(_mm_loadu_ps(y + i), pvy), pvy,
+                                   _mm_sub_ps(targetTop, hh), _mm_add_ps(targetBottom, hh), enter, exit);
+        const __m128 hit = _mm_and_ps(_mm_and_ps(validX, validY),
+                                      _mm_and_ps(_mm_cmplt_ps(enter, exit),
+                                                 _mm_and_ps(_mm_cmplt_ps(enter, one), _mm_cmpgt_ps(exit, zero))));
+        _mm_storeu_ps(outTimes + i, select(hit, _mm_max_ps(enter, zero), infinity));
+    }
+    sweepTargetScalar(x + i, y + i, vx + i, vy + i, halfWidth + i, halfHeight + i, count - i, target, outTimes + i);
+}
+
+const char* ProjectileKernels::instructionSet() { return "SSE2"; }
+
+#else
+
+void ProjectileKernels::integrate(float* x, float* y, const float* vx, const float* vy, std::size_t count) {
+    integrateScalar(x, y, vx, vy, count);
+}
+
+void ProjectileKernels::flagOutOfBounds(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                        std::size_t count, float areaWidth, float areaHeight, std::uint8_t* outFlags) {
+    flagOutOfBoundsScalar(x, y, halfWidth, halfHeight, count, areaWidth, areaHeight, outFlags);
+}
+
+void ProjectileKernels::overlapTarget(const float* x, const float* y, const float* halfWidth, const float* halfHeight,
+                                      std::size_t count, const sf::FloatRect& target, std::uint8_t* outFlags) {
+    overlapTargetScalar(x, y, halfWidth, halfHeight, count, target, outFlags);
+}
+
+void ProjectileKernels::sweepTarget(const float* x, const float* y, const float* vx, const float* vy,
+                                    const float* halfWidth, const float* halfHeight,
+                                    std::size_t count, const sf::FloatRect& target, float* outTimes) {
+    sweepTargetScalar(x, y, vx, vy, halfWidth, halfHeight, count, target, outTimes);
+}
+
+const char* ProjectileKernels::instructionSet() { return "scalar"; }
+
+#endif
@@ -0,0 +1,126 @@
+#include "../class_headers/RenderBench.h"
+#include "../class_headers/RenderSnapshot.h"
+#include "../class_headers/TextureCache.h"
+#include "../class_headers/TimingStats.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+RenderBench::RenderBench(RenderBenchOptions options) : options(std::move(options)) {
+    if (this->options.spriteCounts.empty() || this->options.framesPerCount == 0 || this->options.width == 0 || this->options.height == 0) {
+        throw ConfigurationError("Render bench needs at least one sprite count, one frame and a non-empty target");
+    }
+}
+
+void RenderBench::buildSpriteScene(RenderSnapshot& out, std::size_t count, sf::Vector2u area, unsigned int seed) {
+    constexpr int frameSize{96}; // berserk orc sheets, 4 idle frames
+    const sf::Texture& texture = TextureCache::getInstance().get("assets/enemies/berserk/Idle.png");
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xDist(0.f, static_cast<float>(area.x));
+    std::uniform_real_distribution<float> yDist(0.f, static_cast<float>(area.y));
+    std::uniform_int_distribution<int> frameDist(0, 3);
+
+    sf::Sprite sprite(texture);
+    sprite.setOrigin(frameSize / 2.f, frameSize / 2.f);
+    for (std::size_t i = 0; i < count; ++i) {
+        sprite.setTextureRect(sf::IntRect(frameDist(rng) * frameSize, 0, frameSize, frameSize));
+        sprite.setPosition(xDist(rng), yDist(rng));
+        out.addSprite(sprite);
+    }
+}
+
+std::vector<RenderBenchResult> RenderBench::run() const {
+    sf::RenderTexture target;
+    if (!target.create(options.width, options.height)) {
+        throw GameError("Render bench could not create a " + std::to_string(options.width) + "x" + std::to_string(options.height) +
+                        " render texture (no GL context? try xvfb-run)");
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto toMs = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+    std::vector<RenderBenchResult> results;
+    RenderSnapshot frame;
+    std::vector<double> submitMs;
+    submitMs.reserve(options.framesPerCount);
+
+    for (const std::size_t count : options.spriteCounts) {
+        frame.clear();
+        buildSpriteScene(frame, count, {options.width, options.height}, 1);
+        for (std::size_t i = 0; i < options.warmupFrames; ++i) {
+            target.clear();
+            frame.drawTo(target);
+            target.display();
+        }
+        (void)target.getTexture().copyToImage(); // start measuring with an idle GPU
+
+        submitMs.clear();
+        const auto batchStart = Clock::now();
+        for (std::size_t i = 0; i < options.framesPerCount; ++i) {
+            const auto frameStart = Clock::now();
+            target.clear();
+            frame.drawTo(target);
+            target.display();
+            submitMs.push_back(toMs(Clock::now() - frameStart));
+        }
+        (void)target.getTexture().copyToImage(); // wait until the GPU drew every frame
+        const double batchMs = toMs(Clock::now() - batchStart);
+
+        RenderBenchResult result;
+        result.sprites = count;
+        result.framesPerSecond = batchMs > 0.0 ? static_cast<double>(options.framesPerCount) * 1000.0 / batchMs : 0.0;
+        double sum = 0.0;
+        for (double value : submitMs) sum += value;
+        result.meanSubmitMs = sum / static_cast<double>(submitMs.size());
+        std::ranges::sort(submitMs);
+        result.p99SubmitMs = TimingStats::percentile(submitMs, 0.99);
+        results.push_back(result);
+    }
+    return results;
+}
+
+void RenderBench::printResults(const std::vector<RenderBenchResult>& results) {
+    std::cout << std::fixed << std::setprecision(3) << "--- render bench ---\n"
+              << std::setw(10) << "sprites" << std::setw(12) << "fps" << std::setw(14) << "submit ms" << std::setw(14) << "submit p99" << "\n";
+    for (const RenderBenchResult& result : results) {
+        std::cout << std::setw(10) << result.sprites << std::setw(12) << result.framesPerSecond
+                  << std::setw(14) << result.meanSubmitMs << std::setw(14) << result.p99SubmitMs << "\n";
+    }
+    std::cout.flush();
+}
+
+int RenderBench::runFromCommandLine(const std::vector<std::string>& args) {
+    try {
+        RenderBenchOptions options;
+        if (auto spritesArg = std::ranges::find(args, "--sprites"); spritesArg != args.end() && std::next(spritesArg) != args.end()) {
+            options.spriteCounts.clear();
+            std::istringstream list(*std::next(spritesArg));
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                std::size_t parsed = 0;
+                const unsigned long count = std::stoul(item, &parsed);
+                if (parsed != item.size()) throw ConfigurationError("Bad sprite count '" + item + "' for --sprites");
+                options.spriteCounts.push_back(count);
+            }
+        }
+        if (auto framesArg = std::ranges::find(args, "--frames"); framesArg != args.end() && std::next(framesArg) != args.end()) {
+            options.framesPerCount = std::stoul(*std::next(framesArg));
+        }
+        RenderBench bench(std::move(options));
+        printResults(bench.run());
+        return 0;
+    } catch (const GameError& e) {
+        std::cerr << "\n--- RENDER BENCH FAILED ---\n" << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "\n--- STANDARD EXCEPTION CAUGHT ---\n" << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,189 @@
+#include "../class_headers/RenderSnapshot.h"
+#include <algorithm>
+
+namespace {
+    struct PreparedFont {
+        const sf::Font* font;
+        unsigned int characterSize;
+        float outlineThickness;
+
+        bool operator==(const PreparedFont&) const = default;
+    };
+
+    std::vector<PreparedFont> preparedFonts; // building thread, or a loader before it hands the font over; a handful of entries
+
+    // same quad as sf::Text, two triangles with a pixel of padding around the glyph
+    sf::Vertex* addGlyphQuad(sf::Vertex* out, sf::Vector2f position, sf::Color color, const sf::Glyph& glyph, float italicShear) {
+        constexpr float padding{1.f};
+        const float left = glyph.bounds.left - padding;
+        const float top = glyph.bounds.top - padding;
+        const float right = glyph.bounds.left + glyph.bounds.width + padding;
+        const float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+        const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+        const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+        const float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+        const float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+        *out++ = sf::Vertex({position.x + left - italicShear * top, position.y + top}, color, {u1, v1});
+        *out++ = sf::Vertex({position.x + right - italicShear * top, position.y + top}, color, {u2, v1});
+        *out++ = sf::Vertex({position.x + left - italicShear * bottom, position.y + bottom}, color, {u1, v2});
+        *out++ = sf::Vertex({position.x + left - italicShear * bottom, position.y + bottom}, color, {u1, v2});
+        *out++ = sf::Vertex({position.x + right - italicShear * top, position.y + top}, color, {u2, v1});
+        *out++ = sf::Vertex({position.x + right - italicShear * bottom, position.y + bottom}, color, {u2, v2});
+        return out;
+    }
+
+    bool isWhitespace(sf::Uint32 character) { return character == ' ' || character == '\t' || character == '\n' || character == '\r'; }
+}
+
+void RenderSnapshot::prepareFont(const sf::Font& font, unsigned int characterSize, float outlineThickness) {
+    const PreparedFont key{&font, characterSize, outlineThickness};
+    if (std::ranges::find(preparedFonts, key) != preparedFonts.end()) return;
+    // one page per size holds every style, so regular and bold are loaded together
+    for (sf::Uint32 character = 0x20; character < 0x7f; ++character) { // may grow the page texture, nobody draws from it yet
+        for (const bool bold : {false, true}) {
+            font.getGlyph(character, characterSize, bold);
+            if (outlineThickness != 0.f) font.getGlyph(character, characterSize, bold, outlineThickness);
+        }
+    }
+    preparedFonts.push_back(key);
+}
+
+void RenderSnapshot::clear() {
+    items.clear();
+    vertices.clear();
+    currentLayer = RenderLayer::ENTITIES;
+}
+
+void RenderSnapshot::setLayer(RenderLayer layer) { currentLayer = layer; }
+
+void RenderSnapshot::addSprite(const sf::Sprite& sprite) {
+    if (!sprite.getTexture()) return;
+    RenderItem& item = items.emplace_back();
+    item.layer = currentLayer;
+    item.kind = RenderItem::Kind::SPRITE;
+    item.texture = sprite.getTexture();
+    item.textureRect = sprite.getTextureRect();
+    item.transform = sprite.getTransform();
+    item.fillColor = sprite.getColor();
+}
+
+void RenderSnapshot::addRectangle(const sf::RectangleShape& shape) {
+    RenderItem& item = items.emplace_back();
+    item.layer = currentLayer;
+    item.kind = RenderItem::Kind::RECTANGLE;
+    item.size = shape.getSize();
+    item.transform = shape.getTransform();
+    item.fillColor = shape.getFillColor();
+    item.outlineColor = shape.getOutlineColor();
+    item.outlineThickness = shape.getOutlineThickness();
+}
+
+void RenderSnapshot::addRectangle(const sf::FloatRect& rect, sf::Color fill, sf::Color outline, float outlineThickness) {
+    RenderItem& item = items.emplace_back();
+    item.layer = currentLayer;
+    item.kind = RenderItem::Kind::RECTANGLE;
+    item.size = {rect.width, rect.height};
+    item.transform.translate(rect.left, rect.top);
+    item.fillColor = fill;
+    item.outlineColor = outline;
+    item.outlineThickness = outlineThickness;
+}
+
+void RenderSnapshot::addText(const sf::Text& text) {
+    const sf::Font* font = text.getFont();
+    const sf::String& string = text.getString();
+    if (!font || string.isEmpty()) return;
+    const unsigned int size = text.getCharacterSize();
+    const bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+    const float outline = text.getOutlineThickness();
+    prepareFont(*font, size, outline);
+
+    // the layout of sf::Text::ensureGeometryUpdate, outline quads first so the fill is drawn over them
+    const auto glyphs = static_cast<std::size_t>(std::ranges::count_if(string, [](sf::Uint32 c) { return !isWhitespace(c); }));
+    if (glyphs == 0) return;
+    const std::size_t passes = outline != 0.f ? 2 : 1;
+    const std::span<sf::Vertex> quads = addVertices(glyphs * passes * 6, sf::Triangles, &font->getTexture(size));
+    items.back().transform = text.getTransform();
+
+    const float italicShear = (text.getStyle() & sf::Text::Italic) ? 0.209f : 0.f; // 12 degrees, as sf::Text
+    float whitespaceWidth = font->getGlyph(' ', size, bold).advance;
+    const float letterSpacing = (whitespaceWidth / 3.f) * (text.getLetterSpacing() - 1.f);
+    whitespaceWidth += letterSpacing;
+    const float lineSpacing = font->getLineSpacing(size) * text.getLineSpacing();
+    sf::Vertex* outlineOut = quads.data();
+    sf::Vertex* fillOut = quads.data() + (passes == 2 ? glyphs * 6 : 0);
+    float x = 0.f;
+    float y = static_cast<float>(size);
+    sf::Uint32 previous = 0;
+    for (const sf::Uint32 character : string) {
+        if (character == '\r') continue;
+        x += font->getKerning(previous, character, size, bold);
+        previous = character;
+        switch (character) {
+            case ' ': x += whitespaceWidth; continue;
+            case '\t': x += whitespaceWidth * 4; continue;
+            case '\n': y += lineSpacing; x = 0; continue;
+            default: break;
+        }
+        if (passes == 2) {
+            outlineOut = addGlyphQuad(outlineOut, {x, y}, text.getOutlineColor(), font->getGlyph(character, size, bold, outline), italicShear);
+        }
+        const sf::Glyph& glyph = font->getGlyph(character, size, bold);
+        fillOut = addGlyphQuad(fillOut, {x, y}, text.getFillColor(), glyph, italicShear);
+        x += glyph.advance + letterSpacing;
+    }
+}
+
+std::span<sf::Vertex> RenderSnapshot::addVertices(std::size_t count, sf::PrimitiveType primitive, const sf::Texture* texture,
+                                                  const sf::BlendMode& blendMode) {
+    const std::size_t first = vertices.size();
+    vertices.resize(first + count);
+    RenderItem& item = items.emplace_back();
+    item.layer = currentLayer;
+    item.kind = RenderItem::Kind::VERTICES;
+    item.texture = texture;
+    item.firstVertex = static_cast<std::uint32_t>(first);
+    item.vertexCount = static_cast<std::uint32_t>(count);
+    item.primitive = primitive;
+    item.blendMode = blendMode;
+    return {vertices.data() + first, count};
+}
+
+void RenderSnapshot::drawTo(sf::RenderTarget& target) const {
+    RenderStats discarded;
+    RenderStatsTarget counted(target, discarded);
+    drawTo(counted);
+}
+
+void RenderSnapshot::drawTo(RenderStatsTarget& target) const {
+    sf::Sprite sprite; // scratch objects reconfigured per item, drawn with the item's transform
+    sf::RectangleShape rectangle;
+    for (const RenderItem& item : items) {
+        switch (item.kind) {
+            case RenderItem::Kind::SPRITE:
+                sprite.setTexture(*item.texture);
+                sprite.setTextureRect(item.textureRect);
+                sprite.setColor(item.fillColor);
+                target.draw(sprite, item.layer, 4, 1, item.texture, sf::RenderStates(item.transform));
+                break;
+            case RenderItem::Kind::RECTANGLE: {
+                rectangle.setSize(item.size);
+                rectangle.setFillColor(item.fillColor);
+                rectangle.setOutlineColor(item.outlineColor);
+                rectangle.setOutlineThickness(item.outlineThickness);
+                const bool outlined = item.outlineThickness != 0.f; // the outline is a second triangle strip
+                target.draw(rectangle, item.layer, outlined ? 16 : 6, outlined ? 2 : 1, nullptr, sf::RenderStates(item.transform));
+                break;
+            }
+            case RenderItem::Kind::VERTICES: {
+                sf::RenderStates states(item.transform);
+                states.texture = item.texture;
+                states.blendMode = item.blendMode;
+                target.draw(vertices.data() + item.firstVertex, item.vertexCount, item.primitive, item.layer, states);
+                break;
+            }
+        }
+    }
+}
+
+std::size_t RenderSnapshot::size() const { return items.size(); }
@@ -0,0 +1,85 @@
+#include "../class_headers/RenderStats.h"
+#include <iomanip>
+#include <sstream>
+
+RenderCounters& RenderCounters::operator+=(const RenderCounters& other) {
+    drawCalls += other.drawCalls;
+    vertices += other.vertices;
+    textureSwitches += other.textureSwitches;
+    stateChanges += other.stateChanges;
+    return *this;
+}
+
+RenderStats& RenderStats::operator+=(const RenderStats& other) {
+    for (std::size_t i = 0; i < layers.size(); ++i) layers[i] += other.layers[i];
+    return *this;
+}
+
+RenderCounters RenderStats::total() const {
+    RenderCounters sum;
+    for (const RenderCounters& layer : layers) sum += layer;
+    return sum;
+}
+
+void RenderStats::clear() { layers.fill({}); }
+
+const char* RenderStats::layerName(RenderLayer layer) {
+    switch (layer) {
+        case RenderLayer::BACKGROUND: return "background";
+        case RenderLayer::PLATFORMS: return "platforms";
+        case RenderLayer::ENTITIES: return "entities";
+        case RenderLayer::PROJECTILES: return "projectiles";
+        case RenderLayer::PARTICLES: return "particles";
+        case RenderLayer::UI: return "ui";
+        case RenderLayer::COUNT: break;
+    }
+    return "?";
+}
+
+std::string RenderStats::format(double frames) const {
+    if (frames <= 0.0) frames = 1.0;
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(frames == 1.0 ? 0 : 1);
+    auto line = [&](const char* name, const RenderCounters& counters) {
+        out << std::left << std::setw(12) << name << std::right
+            << " draws " << std::setw(7) << static_cast<double>(counters.drawCalls) / frames
+            << "  verts " << std::setw(9) << static_cast<double>(counters.vertices) / frames
+            << "  tex " << std::setw(6) << static_cast<double>(counters.textureSwitches) / frames
+            << "  state " << std::setw(6) << static_cast<double>(counters.stateChanges) / frames << "\n";
+    };
+    line("total", total());
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        if (layers[i].drawCalls > 0) line(layerName(static_cast<RenderLayer>(i)), layers[i]);
+    }
+    return out.str();
+}
+
+RenderStatsTarget::RenderStatsTarget(sf::RenderTarget& target, RenderStats& stats) : target(target), stats(stats) {}
+
+void RenderStatsTarget::count(RenderLayer layer, std::uint64_t vertices, std::uint64_t drawCalls, const void* textureKey,
+                              const sf::BlendMode& blendMode) {
+    RenderCounters& counters = stats[layer];
+    counters.drawCalls += drawCalls;
+    counters.vertices += vertices;
+    const bool textureChanged = first || textureKey != lastTexture;
+    const bool blendChanged = first || !(blendMode == lastBlendMode);
+    if (textureChanged) ++counters.textureSwitches;
+    if (textureChanged || blendChanged) ++counters.stateChanges;
+    lastTexture = textureKey;
+    lastBlendMode = blendMode;
+    first = false;
+}
+
+void RenderStatsTarget::draw(const sf::Drawable& drawable, RenderLayer layer, std::uint64_t vertices, std::uint64_t drawCalls,
+                             const void* textureKey, const sf::RenderStates& states) {
+    count(layer, vertices, drawCalls, textureKey, states.blendMode);
+    target.draw(drawable, states);
+}
+
+void RenderStatsTarget::draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType primitive, RenderLayer layer,
+                             const sf::RenderStates& states) {
+    count(layer, vertexCount, 1, states.texture, states.blendMode);
+    target.draw(vertices, vertexCount, primitive, states);
+}
+
+sf::RenderTarget& RenderStatsTarget::getTarget() const { return target; }
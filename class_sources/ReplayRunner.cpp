@@ -0,0 +1,204 @@
+#include "../class_headers/ReplayRunner.h"
+#include "../class_headers/World.h"
+#include "../class_headers/ConcreteEntityFactory.h"
+#include "../class_headers/EventBus.h"
+#include "../class_headers/AllocationTracker.h"
+#include "../class_headers/StressRunner.h"
+#include "../class_headers/TimingStats.h"
+#include "../class_headers/KeyValueFile.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+ReplayBudget ReplayBudget::loadFromFile(const std::string& path) {
+    ReplayBudget budget;
+    KeyValueFile::forEachEntry(path, "Replay budget", [&](const std::string& key, const std::string& value, int lineNumber) {
+        std::optional<double>* limit = nullptr;
+        if (key == "max_p95_frame_ms") limit = &budget.maxP95FrameMs;
+        else if (key == "max_p99_frame_ms") limit = &budget.maxP99FrameMs;
+        else if (key == "max_frame_ms") limit = &budget.maxFrameMs;
+        else if (key == "max_mean_tick_ms") limit = &budget.maxMeanTickMs;
+        else if (key == "max_p99_tick_ms") limit = &budget.maxP99TickMs;
+        else if (key == "max_peak_entities") limit = &budget.maxPeakEntities;
+        else if (key == "max_allocations_per_frame") limit = &budget.maxAllocationsPerFrame;
+        else if (key == "max_peak_allocations_per_frame") limit = &budget.maxPeakAllocationsPerFrame;
+        else if (key == "max_peak_rss_mib") limit = &budget.maxPeakResidentMiB;
+        else if (key == "max_allocation_violation_frames") limit = &budget.maxAllocationViolationFrames;
+        else throw ConfigurationError("Unknown key '" + key + "' in " + path + ":" + std::to_string(lineNumber));
+        *limit = KeyValueFile::parseValue<double>(key, value, path, lineNumber);
+    });
+    return budget;
+}
+
+ReplayRunner::ReplayRunner(InputRecording recording, bool headless) : recording(std::move(recording)), headless(headless) {}
+
+ReplayReport ReplayRunner::run(AllocationFrameLog& allocationLog) const {
+    sf::RenderWindow window(sf::VideoMode({windowWidth, windowHeight}), "ToonLander replay", sf::Style::Default);
+    window.setVisible(!headless);
+    window.setVerticalSyncEnabled(false); // measure the frame cost, not the display rate
+
+    EventBus eventBus; // no sound, events are dropped
+    World world(&window, std::make_unique<ConcreteEntityFactory>(), &eventBus);
+
+    std::vector<double> frameMs, tickMs;
+    frameMs.reserve(recording.size());
+    tickMs.reserve(recording.size());
+    ReplayReport report;
+    std::uint64_t steadyAllocations = 0;
+    using Clock = std::chrono::steady_clock;
+    auto toMs = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+    const std::uint64_t allocationsAtStart = AllocationTracker::getAllocationCount();
+
+    for (std::size_t tick = 0; tick < recording.size() && window.isOpen(); ++tick) {
+        const std::uint64_t allocationsBefore = AllocationTracker::getAllocationCount();
+        allocationLog.beginFrame();
+        world.getFrameArena().reset();
+        const auto frameStart = Clock::now();
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) window.close();
+        }
+
+        world.handleInput(recording.at(tick), {});
+        world.update(InputRecording::tickSeconds);
+        eventBus.discardPending();
+        const auto tickEnd = Clock::now();
+
+        window.clear();
+        world.draw();
+        window.display();
+        const auto frameEnd = Clock::now();
+
+        allocationLog.endFrame(tick);
+        tickMs.push_back(toMs(tickEnd - frameStart));
+        frameMs.push_back(toMs(frameEnd - frameStart));
+        report.peakEntities = std::max(report.peakEntities, world.getEntityCount());
+        if (tick >= warmupFrames) {
+            const std::uint64_t frameAllocations = AllocationTracker::getAllocationCount() - allocationsBefore;
+            steadyAllocations += frameAllocations;
+            report.peakAllocationsPerFrame = std::max(report.peakAllocationsPerFrame, frameAllocations);
+        }
+        if (world.isGameOver()) {
+            report.reachedGameOver = true;
+            break;
+        }
+    }
+
+    report.frames = frameMs.size();
+    report.totalAllocations = AllocationTracker::getAllocationCount() - allocationsAtStart;
+    report.allocationViolationFrames = allocationLog.getFramesWithViolations();
+    world.getFrameArena().reset(); // counts the last frame
+    report.frameArenaPeakBytes = world.getFrameArena().getStats().peakBytes;
+    report.frameArenaOverflowFrames = world.getFrameArena().getStats().overflowFrames;
+    report.worldArenaPeakBytes = world.getWorldArena().getStats().runPeakBytes;
+    if (report.frames > warmupFrames) {
+        report.allocationsPerFrame = static_cast<double>(steadyAllocations) / static_cast<double>(report.frames - warmupFrames);
+    }
+    if (report.frames > 0) {
+        double tickSum = 0.0;
+        for (double value : tickMs) tickSum += value;
+        report.meanTickMs = tickSum / static_cast<double>(tickMs.size());
+        std::ranges::sort(tickMs);
+        report.p99TickMs = TimingStats::percentile(tickMs, 0.99);
+        std::ranges::sort(frameMs);
+        report.p50FrameMs = TimingStats::percentile(frameMs, 0.50);
+        report.p95FrameMs = TimingStats::percentile(frameMs, 0.95);
+        report.p99FrameMs = TimingStats::percentile(frameMs, 0.99);
+        report.maxFrameMs = frameMs.back();
+    }
+
+    std::vector<std::byte> snapshot;
+    world.saveSnapshot(snapshot);
+    report.finalStateHash = 0xcbf29ce484222325ULL;
+    for (std::byte value : snapshot) {
+        report.finalStateHash = (report.finalStateHash ^ static_cast<std::uint64_t>(value)) * 0x100000001b3ULL;
+    }
+    report.peakResidentBytes = StressRunner::peakResidentSetBytes();
+    return report;
+}
+
+void ReplayRunner::printReport(const ReplayReport& report) {
+    std::cout << std::fixed << std::setprecision(3)
+              << "--- replay report ---\n"
+              << "frames:            " << report.frames << (report.reachedGameOver ? " (ended in game over)" : "") << "\n"
+              << "frame ms p50:      " << report.p50FrameMs << "\n"
+              << "frame ms p95:      " << report.p95FrameMs << "\n"
+              << "frame ms p99:      " << report.p99FrameMs << "\n"
+              << "frame ms max:      " << report.maxFrameMs << "\n"
+              << "tick ms:           " << report.meanTickMs << " mean, " << report.p99TickMs << " p99\n"
+              << "peak entities:     " << report.peakEntities << "\n"
+              << "allocations:       " << report.totalAllocations << " total, " << report.allocationsPerFrame
+              << " per frame, " << report.peakAllocationsPerFrame << " peak frame\n"
+              << "alloc-free breaks: " << report.allocationViolationFrames << " frames\n"
+              << "frame arena:       " << report.frameArenaPeakBytes / 1024 << " KiB peak, "
+              << report.frameArenaOverflowFrames << " overflow frames\n"
+              << "world arena KiB:   " << report.worldArenaPeakBytes / 1024 << " peak\n"
+              << "peak RSS MiB:      " << static_cast<double>(report.peakResidentBytes) / (1024.0 * 1024.0) << "\n"
+              << "final state hash:  " << std::hex << report.finalStateHash << std::dec << std::endl;
+}
+
+std::vector<std::string> ReplayRunner::checkBudget(const ReplayReport& report, const ReplayBudget& budget) {
+    std::vector<std::string> failures;
+    auto check = [&failures](const char* name, double value, const std::optional<double>& limit) {
+        if (limit && value > *limit) {
+            std::ostringstream line;
+            line << name << " = " << value << " exceeds " << *limit;
+            failures.push_back(line.str());
+        }
+    };
+    check("max_p95_frame_ms", report.p95FrameMs, budget.maxP95FrameMs);
+    check("max_p99_frame_ms", report.p99FrameMs, budget.maxP99FrameMs);
+    check("max_frame_ms", report.maxFrameMs, budget.maxFrameMs);
+    check("max_mean_tick_ms", report.meanTickMs, budget.maxMeanTickMs);
+    check("max_p99_tick_ms", report.p99TickMs, budget.maxP99TickMs);
+    check("max_peak_entities", static_cast<double>(report.peakEntities), budget.maxPeakEntities);
+    // without the counting operator new every count is 0, passing the limits would hide that nothing was measured
+    if (!AllocationTracker::isCompiledIn() &&
+        (budget.maxAllocationsPerFrame || budget.maxPeakAllocationsPerFrame || budget.maxAllocationViolationFrames)) {
+        failures.emplace_back("allocation limits need a build configured with -DTRACK_ALLOCATIONS=ON");
+    }
+    check("max_allocations_per_frame", report.allocationsPerFrame, budget.maxAllocationsPerFrame);
+    check("max_peak_allocations_per_frame", static_cast<double>(report.peakAllocationsPerFrame), budget.maxPeakAllocationsPerFrame);
+    check("max_allocation_violation_frames", static_cast<double>(report.allocationViolationFrames), budget.maxAllocationViolationFrames);
+    check("max_peak_rss_mib", static_cast<double>(report.peakResidentBytes) / (1024.0 * 1024.0), budget.maxPeakResidentMiB);
+    return failures;
+}
+
+int ReplayRunner::runFromCommandLine(const std::vector<std::string>& args) {
+    auto replayArg = std::ranges::find(args, "--replay");
+    if (replayArg == args.end() || std::next(replayArg) == args.end()) {
+        std::cerr << "usage: --replay <recording> [--budget <file>] [--headless]" << std::endl;
+        return 2;
+    }
+    try {
+        std::optional<ReplayBudget> budget;
+        if (auto budgetArg = std::ranges::find(args, "--budget"); budgetArg != args.end() && std::next(budgetArg) != args.end()) {
+            budget = ReplayBudget::loadFromFile(*std::next(budgetArg)); // before the run, a typo should not cost a whole replay
+        }
+        const bool headless = std::ranges::find(args, "--headless") != args.end();
+        ReplayRunner runner(InputRecording::loadFromFile(*std::next(replayArg)), headless);
+        AllocationTracker::setEnabled(true); // per-phase counts, the replay is a measurement run anyway
+        AllocationFrameLog allocationLog(warmupFrames);
+        const ReplayReport report = runner.run(allocationLog);
+        printReport(report);
+        allocationLog.printSummary();
+        if (!budget) return 0;
+
+        const std::vector<std::string> failures = checkBudget(report, *budget);
+        for (const std::string& failure : failures) {
+            std::cerr << "BUDGET EXCEEDED: " << failure << "\n";
+        }
+        return failures.empty() ? 0 : 3;
+    } catch (const GameError& e) {
+        std::cerr << "\n--- REPLAY FAILED ---\n" << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "\n--- STANDARD EXCEPTION CAUGHT ---\n" << e.what() << std::endl;
+        return 1;
+    }
+}
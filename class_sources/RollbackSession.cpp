@@ -0,0 +1,209 @@
+#include "../class_headers/RollbackSession.h"
+#include "../class_headers/World.h"
+#include "../class_headers/EventBus.h"
+#include "../class_headers/UdpLink.h"
+#include "../class_headers/GameExceptions.h"
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+RollbackSession::RollbackSession(World& world, EventBus* eventBus, UdpLink& link, const RollbackConfig& config) :
+    world(world),
+    eventBus(eventBus),
+    link(link),
+    config(config),
+    snapshots(config.maxRollback + 2),
+    snapshotTick(config.maxRollback + 2, -1),
+    nextChecksumTick(config.checksumInterval) {
+    if (config.localSlot != 0 && config.localSlot != 1) {
+        throw ConfigurationError("RollbackSession local slot must be 0 or 1");
+    }
+    if (config.maxRollback == 0 || config.checksumInterval == 0 ||
+        config.maxRollback + config.inputDelay + config.redundantInputs >= historySize) {
+        throw ConfigurationError("RollbackSession windows do not fit the input history");
+    }
+    // nobody can have input before the delay has elapsed, those ticks are known to be empty
+    for (std::uint32_t tick = 0; tick < config.inputDelay; ++tick) {
+        recordRemoteInput(tick, {});
+    }
+}
+
+void RollbackSession::recordRemoteInput(std::uint32_t tick, PlayerInput input) {
+    if (tick < remoteContiguous || tick >= remoteContiguous + historySize) return; // old duplicate or absurdly far ahead
+    const std::uint32_t slot = tick % historySize;
+    if (remoteInputTick[slot] == tick + 1) return; // already have it
+    remoteInputs[slot] = input;
+    remoteInputTick[slot] = tick + 1;
+
+    if (tick < currentTick && remoteUsed[slot] != input) { // we simulated a wrong guess
+        rollbackTo = rollbackTo < 0 ? tick : std::min<std::int64_t>(rollbackTo, tick);
+    }
+    while (remoteInputTick[remoteContiguous % historySize] == remoteContiguous + 1) {
+        ++remoteContiguous;
+    }
+}
+
+PlayerInput RollbackSession::remoteInputFor(std::uint32_t tick) const {
+    const std::uint32_t slot = tick % historySize;
+    if (remoteInputTick[slot] == tick + 1) return remoteInputs[slot];
+    if (remoteContiguous == 0) return {};
+    return remoteInputs[(remoteContiguous - 1) % historySize]; // prediction: the player keeps doing the same thing
+}
+
+void RollbackSession::receivePackets() {
+    sf::Packet packet;
+    while (link.receive(packet)) {
+        sf::Uint32 magic = 0, newestTick = 0, checksumTick = 0;
+        sf::Uint8 count = 0;
+        sf::Uint64 checksum = 0;
+        if (!(packet >> magic >> newestTick >> count) || magic != packetMagic || count > newestTick + 1) continue;
+        for (sf::Uint32 i = 0; i < count; ++i) {
+            sf::Uint8 buttons = 0;
+            if (!(packet >> buttons)) break;
+            recordRemoteInput(newestTick + 1 - count + i, PlayerInput{buttons});
+        }
+        if (packet >> checksumTick >> checksum && checksumTick > 0) {
+            remoteChecksums[checksumTick] = checksum;
+        }
+    }
+}
+
+void RollbackSession::sendPacket() {
+    const std::uint32_t count = std::min(config.redundantInputs, newestLocalInputTick + 1);
+    sf::Packet packet;
+    packet << packetMagic << static_cast<sf::Uint32>(newestLocalInputTick) << static_cast<sf::Uint8>(count);
+    for (std::uint32_t tick = newestLocalInputTick + 1 - count; tick <= newestLocalInputTick; ++tick) {
+        packet << static_cast<sf::Uint8>(localInputs[tick % historySize].buttons);
+    }
+    // newest confirmed state hash, the peer compares it with its own
+    if (!localChecksums.empty()) {
+        const auto& [tick, hash] = *localChecksums.rbegin();
+        packet << static_cast<sf::Uint32>(tick) << static_cast<sf::Uint64>(hash);
+    } else {
+        packet << static_cast<sf::Uint32>(0) << static_cast<sf::Uint64>(0);
+    }
+    link.send(packet);
+}
+
+void RollbackSession::simulateTick(std::uint32_t tick) {
+    const std::size_t slot = tick % snapshots.size();
+    world.saveSnapshot(snapshots[slot]); // buffers are reused, no allocation once warm
+    snapshotTick[slot] = tick;
+
+    const PlayerInput local = localInputs[tick % historySize];
+    const PlayerInput remote = remoteInputFor(tick);
+    remoteUsed[tick % historySize] = remote;
+    if (config.localSlot == 0) {
+        world.handleInput(local, remote);
+    } else {
+        world.handleInput(remote, local);
+    }
+    world.update(tickSeconds);
+}
+
+void RollbackSession::rollback() {
+    const auto target = static_cast<std::uint32_t>(rollbackTo);
+    rollbackTo = -1;
+    const std::size_t slot = target % snapshots.size();
+    if (snapshotTick[slot] != target) {
+        throw InvalidStateError("Rollback target fell out of the snapshot window");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    world.loadSnapshot(snapshots[slot]);
+    for (std::uint32_t tick = target; tick < currentTick; ++tick) {
+        simulateTick(tick);
+    }
+    if (eventBus) eventBus->discardPending(); // sounds of the replayed ticks already played once
+    stats.resimulationSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const std::uint32_t depth = currentTick - target;
+    ++stats.rollbacks;
+    stats.rolledBackTicks += depth;
+    stats.maxRollbackDepth = std::max(stats.maxRollbackDepth, depth);
+}
+
+std::uint64_t RollbackSession::hashBlob(const std::vector<std::byte>& blob) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::byte value : blob) {
+        hash = (hash ^ static_cast<std::uint64_t>(value)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void RollbackSession::updateChecksums() {
+    // a state is final once every input before it is confirmed, and we still hold its snapshot
+    while (nextChecksumTick <= remoteContiguous && nextChecksumTick <= currentTick) {
+        const std::size_t slot = nextChecksumTick % snapshots.size();
+        if (nextChecksumTick == currentTick) {
+            std::vector<std::byte>& scratch = snapshots[slot]; // not simulated yet, this is the live state
+            world.saveSnapshot(scratch);
+            snapshotTick[slot] = nextChecksumTick;
+        }
+        if (snapshotTick[slot] == nextChecksumTick) {
+            localChecksums[nextChecksumTick] = hashBlob(snapshots[slot]);
+        }
+        nextChecksumTick += config.checksumInterval;
+    }
+
+    for (auto it = remoteChecksums.begin(); it != remoteChecksums.end();) {
+        auto local = localChecksums.find(it->first);
+        if (local == localChecksums.end()) {
+            const bool expired = !localChecksums.empty() && it->first < localChecksums.begin()->first;
+            it = expired ? remoteChecksums.erase(it) : std::next(it);
+            continue;
+        }
+        ++stats.checksumsCompared;
+        if (local->second != it->second) {
+            ++stats.desyncs;
+            if (stats.firstDesyncTick < 0) stats.firstDesyncTick = it->first;
+        }
+        it = remoteChecksums.erase(it);
+    }
+    while (localChecksums.size() > 8) localChecksums.erase(localChecksums.begin()); // only recent ones matter
+}
+
+bool RollbackSession::advance(const PlayerInput& localInput) {
+    receivePackets();
+
+    // the input sampled now is applied inputDelay ticks later, both peers see it at the same tick
+    const std::uint32_t inputTick = currentTick + config.inputDelay;
+    // while stalled that tick was already sampled and sent, it must not change anymore
+    if (inputTick > newestLocalInputTick || !haveLocalInput) {
+        localInputs[inputTick % historySize] = localInput;
+        newestLocalInputTick = inputTick;
+        haveLocalInput = true;
+    }
+
+    if (rollbackTo >= 0) rollback();
+
+    bool advanced = false;
+    if (currentTick < remoteContiguous + config.maxRollback) {
+        simulateTick(currentTick);
+        ++currentTick;
+        ++stats.ticks;
+        advanced = true;
+    } else {
+        ++stats.stalledTicks; // too far ahead of the remote side, wait instead of predicting more
+    }
+
+    updateChecksums();
+    sendPacket();
+    link.flush();
+    stats.remoteConfirmedTick = remoteContiguous;
+    return advanced;
+}
+
+void RollbackSession::pollNetwork() {
+    receivePackets();
+    if (rollbackTo >= 0) rollback();
+    updateChecksums();
+    sendPacket();
+    link.flush();
+    stats.remoteConfirmedTick = remoteContiguous;
+}
+
+std::uint32_t RollbackSession::getCurrentTick() const { return currentTick; }
+
+const RollbackStats& RollbackSession::getStats() const { return stats; }
@@ -0,0 +1,102 @@
+#include "../class_headers/SimulationLod.h"
+#include "../class_headers/Entity.h"
+#include <algorithm>
+#include <limits>
+
+SimulationScheduler::SimulationScheduler(const SimulationLodConfig& config) : config(config) {}
+
+void SimulationScheduler::schedule(std::span<const std::unique_ptr<Entity>> entities, std::span<const sf::Vector2f> players,
+                                   const sf::FloatRect& view, std::pmr::vector<UpdateMode>& modes) {
+    lastStats = {};
+    modes.assign(entities.size(), UpdateMode::SKIP);
+    const sf::FloatRect awakeArea(view.left - config.viewMargin, view.top - config.viewMargin,
+                                  view.width + 2.f * config.viewMargin, view.height + 2.f * config.viewMargin);
+    const float fullRadiusSquared = config.fullRadius * config.fullRadius;
+    const float sleepRadiusSquared = config.sleepRadius * config.sleepRadius;
+
+    std::size_t wanting = 0;
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        Entity* entity = entities[i].get();
+        if (!entity) continue;
+        SimulationLodState& state = entity->getLodState();
+
+        SimulationLevel level = SimulationLevel::FULL;
+        if (config.enabled && !players.empty() && entity->getHealthPoints() > 0) { // dying ones finish at full rate
+            const sf::Vector2f position = entity->getPosition();
+            float nearestSquared = std::numeric_limits<float>::max();
+            for (const sf::Vector2f& player : players) {
+                const sf::Vector2f offset = position - player;
+                nearestSquared = std::min(nearestSquared, offset.x * offset.x + offset.y * offset.y);
+            }
+            if (nearestSquared > fullRadiusSquared) {
+                level = nearestSquared > sleepRadiusSquared && !awakeArea.contains(position) ? SimulationLevel::SLEEPING
+                                                                                              : SimulationLevel::REDUCED;
+            }
+        }
+        state.level = level;
+
+        switch (level) {
+            case SimulationLevel::FULL:
+                ++lastStats.full;
+                modes[i] = UpdateMode::FULL;
+                ++wanting;
+                break;
+            case SimulationLevel::REDUCED:
+                ++lastStats.reduced;
+                // counted from the last AI update, so an entity deferred by the cap stays due
+                modes[i] = state.ticksSinceUpdate + 1 >= config.reducedInterval ? UpdateMode::FULL : UpdateMode::MOVE_ONLY;
+                if (modes[i] == UpdateMode::FULL) ++wanting;
+                break;
+            case SimulationLevel::SLEEPING:
+                ++lastStats.sleeping;
+                break;
+        }
+    }
+
+    if (!config.enabled || wanting <= config.maxAiUpdatesPerTick || entities.empty()) {
+        lastStats.aiUpdates = wanting;
+        return;
+    }
+
+    // over the cap: near entities first, then due REDUCED ones, both round-robin from the cursor
+    std::size_t budget = config.maxAiUpdatesPerTick;
+    const std::size_t count = entities.size();
+    std::size_t lastGranted = cursor;
+    for (SimulationLevel pass : {SimulationLevel::FULL, SimulationLevel::REDUCED}) {
+        for (std::size_t step = 0; step < count; ++step) {
+            const std::size_t i = (cursor + step) % count;
+            if (modes[i] != UpdateMode::FULL || entities[i]->getLodState().level != pass) continue;
+            if (budget > 0) {
+                --budget;
+                lastGranted = i;
+            } else {
+                modes[i] = UpdateMode::MOVE_ONLY;
+                ++lastStats.deferred;
+            }
+        }
+    }
+    cursor = (lastGranted + 1) % count;
+    lastStats.aiUpdates = config.maxAiUpdatesPerTick;
+}
+
+float SimulationScheduler::consumeTime(SimulationLodState& state, UpdateMode mode, float dt) const {
+    state.pendingSeconds += dt;
+    if (mode != UpdateMode::FULL) {
+        if (state.ticksSinceUpdate < std::numeric_limits<std::uint16_t>::max()) ++state.ticksSinceUpdate;
+        return 0.f;
+    }
+    const float covered = std::min(state.pendingSeconds, config.maxCatchUpSeconds);
+    state.pendingSeconds = 0.f;
+    state.ticksSinceUpdate = 0;
+    return covered;
+}
+
+void SimulationScheduler::setConfig(const SimulationLodConfig& newConfig) { config = newConfig; }
+
+const SimulationLodConfig& SimulationScheduler::getConfig() const { return config; }
+
+const SimulationLodStats& SimulationScheduler::getLastStats() const { return lastStats; }
+
+std::size_t SimulationScheduler::getCursor() const { return cursor; }
+
+void SimulationScheduler::setCursor(std::size_t newCursor) { cursor = newCursor; }
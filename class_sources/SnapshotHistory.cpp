@@ -0,0 +1,63 @@
+#include "../class_headers/SnapshotHistory.h"
+#include "../class_headers/World.h"
+#include "../class_headers/GameExceptions.h"
+#include <fstream>
+#include <cstring>
+#include <iterator>
+
+SnapshotHistory::SnapshotHistory(std::size_t capacity, float intervalSeconds) :
+    keyframes(capacity > 0 ? capacity : 1), interval(intervalSeconds) {}
+
+bool SnapshotHistory::update(float dt, const World& world) {
+    sinceLastCapture += dt;
+    if (sinceLastCapture < interval) return false;
+    sinceLastCapture = 0.f;
+
+    world.saveSnapshot(keyframes[nextSlot]);
+    nextSlot = (nextSlot + 1) % keyframes.size();
+    if (stored < keyframes.size()) ++stored;
+    return true;
+}
+
+bool SnapshotHistory::rewind(World& world, std::size_t keyframesBack) {
+    if (stored == 0) return false;
+    if (keyframesBack >= stored) keyframesBack = stored - 1; // oldest one we still have
+
+    const std::size_t capacity = keyframes.size();
+    const std::size_t slot = (nextSlot + capacity - 1 - keyframesBack) % capacity;
+    world.loadSnapshot(keyframes[slot]);
+
+    // the restored keyframe becomes the newest one
+    nextSlot = (slot + 1) % capacity;
+    stored -= keyframesBack;
+    sinceLastCapture = 0.f;
+    return true;
+}
+
+void SnapshotHistory::clear() {
+    nextSlot = 0;
+    stored = 0;
+    sinceLastCapture = 0.f;
+}
+
+std::size_t SnapshotHistory::size() const { return stored; }
+
+float SnapshotHistory::getInterval() const { return interval; }
+
+void SnapshotHistory::writeFile(const std::string& path, const std::vector<std::byte>& blob) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()))) {
+        throw ResourceLoadError("Snapshot", path, "could not write file");
+    }
+}
+
+std::vector<std::byte> SnapshotHistory::readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw ResourceLoadError("Snapshot", path, "could not open file");
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<std::byte> blob(bytes.size());
+    std::memcpy(blob.data(), bytes.data(), bytes.size());
+    return blob;
+}
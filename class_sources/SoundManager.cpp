@@ -1,4 +1,5 @@
 #include "../class_headers/SoundManager.h"
+#include <filesystem>
 #include <iostream>
 #include <SFML/Audio.hpp>
 
@@ -44,6 +45,7 @@ bool SoundManager::loadSoundBuffer(const std::string& soundName, const std::stri
         return false;
     }
     soundBuffers[soundName] = buffer;
+    bufferFiles[std::filesystem::path(filename).lexically_normal().generic_string()] = soundName;
     std::cout << "  Loaded SoundBuffer '" << soundName << "' from " << filename << std::endl;
     return true;
 }
@@ -58,6 +60,18 @@ void SoundManager::linkEventToSound(GameEvent event, const std::string& soundNam
     }
 }
 
+bool SoundManager::reloadSound(const std::string& path, const std::vector<sf::Int16>& samples, unsigned int channelCount,
+                               unsigned int sampleRate) {
+    auto file = bufferFiles.find(std::filesystem::path(path).lexically_normal().generic_string());
+    if (file == bufferFiles.end()) return false;
+    // loading into the same buffer detaches and re-attaches the sounds that use it, no relinking needed
+    if (!soundBuffers.at(file->second).loadFromSamples(samples.data(), samples.size(), channelCount, sampleRate)) {
+        std::cerr << "  Failed to reload sound buffer: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
 void SoundManager::playSoundForEvent(GameEvent event) {
     if (eventActionSounds.contains(event)) {
         eventActionSounds.at(event).play();
@@ -66,12 +80,17 @@ void SoundManager::playSoundForEvent(GameEvent event) {
     }
 }
 
-void SoundManager::onNotify(GameEvent event) {
-    switch (event) {
+void SoundManager::onNotify(const GameEventData& event) {
+    switch (event.type) {
         case GameEvent::PLAYER_JUMPED:
         case GameEvent::PLAYER_TOOK_DAMAGE:
         case GameEvent::BUTTON_CLICKED:
-            playSoundForEvent(event); // play the sound linked to this event
+            playSoundForEvent(event.type); // play the sound linked to this event
+            break;
+
+        case GameEvent::PLAYER_FIRED: // particles only, no sound yet
+        case GameEvent::PROJECTILE_HIT:
+        case GameEvent::ENEMY_DIED:
             break;
 
         case GameEvent::GAME_STARTED:
@@ -85,7 +104,7 @@ void SoundManager::onNotify(GameEvent event) {
         case GameEvent::GAMEPLAY_STARTED:
             stopMenuTheme();
         default:
-            std::cout << "SoundManager: No specific sound action for event " << static_cast<int>(event) << std::endl;
+            std::cout << "SoundManager: No specific sound action for event " << static_cast<int>(event.type) << std::endl;
             break;
     }
 }
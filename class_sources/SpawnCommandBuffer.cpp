@@ -0,0 +1,44 @@
+#include "../class_headers/SpawnCommandBuffer.h"
+#include "../class_headers/GameExceptions.h"
+#include <algorithm>
+#include <string>
+
+thread_local std::size_t SpawnCommandBuffer::currentLane = 0;
+
+SpawnCommandBuffer::SpawnCommandBuffer(std::size_t reservePerLane, std::pmr::memory_resource* resource) :
+    lanes(resource), // new lanes inherit the resource
+    reservePerLane(reservePerLane) {
+    ensureLanes(1); // lane 0 serves everything outside the parallel pass
+}
+
+void SpawnCommandBuffer::ensureLanes(std::size_t count) {
+    while (lanes.size() < count) {
+        lanes.emplace_back();
+        lanes.back().reserve(reservePerLane);
+    }
+}
+
+void SpawnCommandBuffer::push(const SpawnCommand& command) {
+    if (currentLane >= lanes.size()) { // lanes must exist before the pass starts, growing here would race
+        throw InvalidStateError("SpawnCommandBuffer lane " + std::to_string(currentLane) + " was not prepared.");
+    }
+    lanes[currentLane].push_back(command);
+}
+
+std::size_t SpawnCommandBuffer::totalCount() const {
+    std::size_t total = 0;
+    for (const auto& lane : lanes) total += lane.size();
+    return total;
+}
+
+std::size_t SpawnCommandBuffer::countOf(SpawnKind kind) const {
+    std::size_t total = 0;
+    for (const auto& lane : lanes) {
+        total += static_cast<std::size_t>(std::ranges::count(lane, kind, &SpawnCommand::kind));
+    }
+    return total;
+}
+
+void SpawnCommandBuffer::clear() {
+    for (auto& lane : lanes) lane.clear();
+}
@@ -0,0 +1,50 @@
+#include "../class_headers/StartupTimeline.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+StartupTimeline::Scope::Scope(StartupTimeline& timeline, std::string name) :
+    timeline(timeline), name(std::move(name)), start(Clock::now()) {}
+
+StartupTimeline::Scope::~Scope() { timeline.record(std::move(name), start, Clock::now()); }
+
+StartupTimeline::StartupTimeline() : origin(Clock::now()), mainThread(std::this_thread::get_id()) {}
+
+void StartupTimeline::record(std::string name, Clock::time_point start, Clock::time_point end) {
+    auto toMs = [this](Clock::time_point time) { return std::chrono::duration<double, std::milli>(time - origin).count(); };
+    const bool onMainThread = std::this_thread::get_id() == mainThread;
+    std::lock_guard lock(mutex);
+    spans.push_back({std::move(name), toMs(start), toMs(end), onMainThread});
+}
+
+void StartupTimeline::mark(std::string name) {
+    const Clock::time_point now = Clock::now();
+    record(std::move(name), now, now);
+}
+
+double StartupTimeline::elapsedMs() const { return std::chrono::duration<double, std::milli>(Clock::now() - origin).count(); }
+
+void StartupTimeline::print(std::ostream& out) const {
+    constexpr int barWidth{48};
+    std::vector<Span> sorted;
+    {
+        std::lock_guard lock(mutex);
+        sorted = spans;
+    }
+    std::ranges::stable_sort(sorted, {}, &Span::startMs);
+    double lastMs = 0.0;
+    for (const Span& span : sorted) lastMs = std::max(lastMs, span.endMs);
+    const double msPerColumn = std::max(lastMs, 1.0) / barWidth;
+
+    std::ostringstream text; // the caller's stream formatting stays untouched
+    text << std::fixed << std::setprecision(1) << "--- startup timeline (ms since main) ---\n";
+    for (const Span& span : sorted) {
+        const int first = std::min(static_cast<int>(span.startMs / msPerColumn), barWidth - 1);
+        const int last = std::max(first + 1, std::min(static_cast<int>(span.endMs / msPerColumn + 0.5), barWidth));
+        text << std::setw(8) << span.startMs << " .." << std::setw(8) << span.endMs << "  "
+             << (span.mainThread ? "main  " : "worker") << " |" << std::string(first, ' ') << std::string(last - first, span.endMs > span.startMs ? '#' : '|')
+             << std::string(barWidth - last, ' ') << "| " << span.name << "\n";
+    }
+    out << text.str() << std::flush;
+}
@@ -0,0 +1,238 @@
+#include "../class_headers/StressRunner.h"
+#include "../class_headers/World.h"
+#include "../class_headers/ConcreteEntityFactory.h"
+#include "../class_headers/EventBus.h"
+#include "../class_headers/BulletPattern.h"
+#include "../class_headers/GameExceptions.h"
+#include "../class_headers/SnapshotHistory.h"
+#include "../class_headers/ParticleSystem.h"
+#include "../class_headers/RenderSnapshot.h"
+#include "../class_headers/TimingStats.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+StressRunner::StressRunner(StressScenario scenario, std::string saveSnapshotPath) :
+    scenario(std::move(scenario)), saveSnapshotPath(std::move(saveSnapshotPath)) {}
+
+std::size_t StressRunner::peakResidentSetBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss); // bytes on macOS
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+#endif
+#endif
+}
+
+StressReport StressRunner::run() const {
+    sf::RenderWindow window(sf::VideoMode({windowWidth, windowHeight}), "ToonLander stress: " + scenario.name, sf::Style::Default);
+    window.setVisible(!scenario.headless); // headless still needs a GL context, it is simply never shown
+    window.setVerticalSyncEnabled(false);  // no frame limit, we want the raw frame cost
+
+    EventBus eventBus; // only the particle system listens, the rest is queued and dropped
+    World world(&window, std::make_unique<ConcreteEntityFactory>(), &eventBus);
+    std::optional<ParticleSystem> particles; // hit sparks and death debris, drawn after the world
+    RenderSnapshot particleFrame;
+    if (scenario.particleBudget > 0) {
+        particles.emplace(&eventBus, std::max(ParticleSystem::defaultCapacity, static_cast<std::size_t>(scenario.particleBudget)),
+                          static_cast<std::size_t>(scenario.particleBudget));
+    }
+    world.setPlayerInvulnerable(true); // the workload must not end with a game over
+    SimulationLodConfig lodConfig;
+    lodConfig.enabled = scenario.simulationLod;
+    lodConfig.maxAiUpdatesPerTick = static_cast<std::size_t>(scenario.maxAiUpdatesPerTick);
+    world.setSimulationLod(lodConfig);
+
+    std::mt19937 rng(scenario.seed);
+    std::uniform_real_distribution<float> xDist(0.f, static_cast<float>(windowWidth));
+    std::uniform_real_distribution<float> yDist(0.f, static_cast<float>(windowHeight));
+    std::uniform_real_distribution<float> unitDist(0.f, 1.f);
+
+    for (int i = 0; i < scenario.platforms; ++i) {
+        world.addPlatform(xDist(rng), 200.f + unitDist(rng) * 550.f, 150.f + unitDist(rng) * 250.f, 20.f);
+    }
+    const float orcY = World::berserkOrcGroundY();
+    for (int i = 0; i < scenario.berserkOrcs; ++i) {
+        world.queueSpawn({SpawnKind::BERSERK_ORC, {xDist(rng), orcY}});
+    }
+    for (int i = 0; i < scenario.mageOrcs; ++i) {
+        world.queueSpawn({SpawnKind::MAGE_ORC, {static_cast<float>(windowWidth) * (0.5f + 0.45f * unitDist(rng)), yDist(rng) * 0.6f}});
+    }
+    struct Emitter {
+        PatternEmitter pattern;
+        sf::Vector2f origin;
+    };
+    std::vector<Emitter> emitters; // the pattern engine under load, same spawn path as the mages' attacks
+    for (int i = 0; i < scenario.patternEmitters; ++i) {
+        emitters.push_back({PatternEmitter(scenario.pattern),
+                            {static_cast<float>(windowWidth) * (0.5f + 0.45f * unitDist(rng)), yDist(rng) * 0.6f}});
+    }
+    world.update(0.f); // creates the initial population, textures end up in the cache before timing starts
+    eventBus.dispatch();
+    if (!scenario.startSnapshot.empty()) { // start mid-fight instead of from the spawn layout
+        world.loadSnapshot(SnapshotHistory::readFile(scenario.startSnapshot));
+    }
+
+    const auto frameCount = static_cast<std::size_t>(std::ceil(scenario.durationSeconds / tickSeconds));
+    std::vector<double> frameMs, simulationMs, drawMs;
+    frameMs.reserve(frameCount);
+    simulationMs.reserve(frameCount);
+    drawMs.reserve(frameCount);
+
+    StressReport report;
+    report.scenarioName = scenario.name;
+    const DirectionTable& directions = DirectionTable::getInstance();
+    float bulletBudget = 0.f;
+    using Clock = std::chrono::steady_clock;
+    auto toMs = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    for (std::size_t frame = 0; frame < frameCount && window.isOpen(); ++frame) {
+        world.getFrameArena().reset();
+        const auto frameStart = Clock::now();
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) window.close();
+        }
+
+        bulletBudget += scenario.projectilesPerSecond * tickSeconds; // fractional bullets carry over
+        for (; bulletBudget >= 1.f; bulletBudget -= 1.f) {
+            const bool playerShot = unitDist(rng) < scenario.playerProjectileShare;
+            world.queueSpawn({playerShot ? SpawnKind::PLAYER_PROJECTILE : SpawnKind::MAGIC_PROJECTILE,
+                              {xDist(rng), yDist(rng)}, directions.at(unitDist(rng) * BulletPatterns::fullTurn), 4.f});
+        }
+        for (Emitter& emitter : emitters) { // aimed left, across the screen towards the player
+            emitter.pattern.update(tickSeconds, emitter.origin, BulletPatterns::fullTurn / 2.f,
+                                   [&world](const SpawnCommand& command) { world.queueSpawn(command); });
+        }
+        world.update(tickSeconds);
+        eventBus.dispatch();
+        if (particles) particles->update(tickSeconds);
+        const auto simulationEnd = Clock::now();
+
+        window.clear();
+        RenderStatsTarget counted(window, report.renderTotals);
+        world.draw(counted);
+        if (particles) {
+            particleFrame.clear();
+            particles->appendRenderItems(particleFrame);
+            particleFrame.drawTo(counted);
+        }
+        window.display();
+        const auto frameEnd = Clock::now();
+
+        simulationMs.push_back(toMs(simulationEnd - frameStart));
+        drawMs.push_back(toMs(frameEnd - simulationEnd));
+        frameMs.push_back(toMs(frameEnd - frameStart));
+        report.peakEntities = std::max(report.peakEntities, world.getEntityCount());
+        const SimulationLodStats& lod = world.getSimulationLodStats();
+        report.meanAiUpdates += static_cast<double>(lod.aiUpdates);
+        report.meanDeferredAiUpdates += static_cast<double>(lod.deferred);
+        report.meanSleeping += static_cast<double>(lod.sleeping);
+    }
+
+    if (particles) {
+        report.peakParticles = particles->getStats().peak;
+        report.droppedParticles = particles->getStats().dropped;
+    }
+    report.frames = frameMs.size();
+    if (report.frames > 0) {
+        report.meanAiUpdates /= static_cast<double>(report.frames);
+        report.meanDeferredAiUpdates /= static_cast<double>(report.frames);
+        report.meanSleeping /= static_cast<double>(report.frames);
+        auto mean = [](const std::vector<double>& values) {
+            double sum = 0.0;
+            for (double value : values) sum += value;
+            return sum / static_cast<double>(values.size());
+        };
+        report.meanSimulationMs = mean(simulationMs);
+        report.meanDrawMs = mean(drawMs);
+        std::ranges::sort(frameMs);
+        report.p50FrameMs = TimingStats::percentile(frameMs, 0.50);
+        report.p95FrameMs = TimingStats::percentile(frameMs, 0.95);
+        report.p99FrameMs = TimingStats::percentile(frameMs, 0.99);
+        report.maxFrameMs = frameMs.back();
+    }
+
+    std::vector<std::byte> snapshot; // cost of one save/restore of the final state
+    const auto saveStart = Clock::now();
+    world.saveSnapshot(snapshot);
+    const auto saveEnd = Clock::now();
+    world.loadSnapshot(snapshot);
+    const auto loadEnd = Clock::now();
+    report.snapshotBytes = snapshot.size();
+    report.snapshotSaveUs = toMs(saveEnd - saveStart) * 1000.0;
+    report.snapshotLoadUs = toMs(loadEnd - saveEnd) * 1000.0;
+    if (!saveSnapshotPath.empty()) SnapshotHistory::writeFile(saveSnapshotPath, snapshot);
+
+    report.peakResidentBytes = peakResidentSetBytes();
+    return report;
+}
+
+void StressRunner::printReport(const StressReport& report) {
+    std::cout << std::fixed << std::setprecision(3)
+              << "--- stress report: " << report.scenarioName << " ---\n"
+              << "frames:          " << report.frames << "\n"
+              << "frame ms p50:    " << report.p50FrameMs << "\n"
+              << "frame ms p95:    " << report.p95FrameMs << "\n"
+              << "frame ms p99:    " << report.p99FrameMs << "\n"
+              << "frame ms max:    " << report.maxFrameMs << "\n"
+              << "simulation ms:   " << report.meanSimulationMs << " (mean)\n"
+              << "draw ms:         " << report.meanDrawMs << " (mean)\n"
+              << "peak entities:   " << report.peakEntities << "\n"
+              << "AI updates/tick: " << report.meanAiUpdates << " (" << report.meanDeferredAiUpdates << " deferred, "
+              << report.meanSleeping << " asleep)\n"
+              << "peak particles:  " << report.peakParticles << " (" << report.droppedParticles << " over budget)\n"
+              << "peak RSS MiB:    " << static_cast<double>(report.peakResidentBytes) / (1024.0 * 1024.0) << "\n"
+              << "snapshot bytes:  " << report.snapshotBytes << "\n"
+              << "snapshot save us: " << report.snapshotSaveUs << "\n"
+              << "snapshot load us: " << report.snapshotLoadUs << "\n"
+              << "render counters, mean per frame:\n" << report.renderTotals.format(static_cast<double>(std::max<std::size_t>(report.frames, 1)))
+              << std::flush;
+}
+
+int StressRunner::runFromCommandLine(const std::vector<std::string>& args) {
+    auto stressArg = std::ranges::find(args, "--stress");
+    if (stressArg == args.end() || std::next(stressArg) == args.end()) {
+        std::cerr << "usage: --stress <scenario file> [--headless] [--save-snapshot <file>]" << std::endl;
+        return 2;
+    }
+    try {
+        StressScenario scenario = StressScenario::loadFromFile(*std::next(stressArg));
+        if (std::ranges::find(args, "--headless") != args.end()) scenario.headless = true;
+        std::string saveSnapshotPath;
+        if (auto saveArg = std::ranges::find(args, "--save-snapshot"); saveArg != args.end() && std::next(saveArg) != args.end()) {
+            saveSnapshotPath = *std::next(saveArg);
+        }
+        StressRunner runner(std::move(scenario), std::move(saveSnapshotPath));
+        printReport(runner.run());
+        return 0;
+    } catch (const GameError& e) {
+        std::cerr << "\n--- STRESS RUN FAILED ---\n" << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "\n--- STANDARD EXCEPTION CAUGHT ---\n" << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,38 @@
+#include "../class_headers/StressScenario.h"
+#include "../class_headers/GameExceptions.h"
+#include "../class_headers/KeyValueFile.h"
+
+StressScenario StressScenario::loadFromFile(const std::string& path) {
+    StressScenario scenario;
+    scenario.name = path;
+    using KeyValueFile::parseValue;
+    KeyValueFile::forEachEntry(path, "Stress scenario", [&](const std::string& key, const std::string& value, int lineNumber) {
+        if (key == "name") scenario.name = value;
+        else if (key == "berserk_orcs") scenario.berserkOrcs = parseValue<int>(key, value, path, lineNumber);
+        else if (key == "mage_orcs") scenario.mageOrcs = parseValue<int>(key, value, path, lineNumber);
+        else if (key == "projectiles_per_second") scenario.projectilesPerSecond = parseValue<float>(key, value, path, lineNumber);
+        else if (key == "player_projectile_share") scenario.playerProjectileShare = parseValue<float>(key, value, path, lineNumber);
+        else if (key == "platforms") scenario.platforms = parseValue<int>(key, value, path, lineNumber);
+        else if (key == "duration") scenario.durationSeconds = parseValue<float>(key, value, path, lineNumber);
+        else if (key == "seed") scenario.seed = parseValue<unsigned int>(key, value, path, lineNumber);
+        else if (key == "snapshot") scenario.startSnapshot = value;
+        else if (key == "simulation_lod") scenario.simulationLod = parseValue<int>(key, value, path, lineNumber) != 0;
+        else if (key == "max_ai_updates_per_tick") scenario.maxAiUpdatesPerTick = parseValue<int>(key, value, path, lineNumber);
+        else if (key == "particle_budget") scenario.particleBudget = parseValue<int>(key, value, path, lineNumber);
+        else if (key == "pattern") {
+            const BulletPattern* preset = BulletPatterns::findPreset(value);
+            if (!preset) throw ConfigurationError("Unknown bullet pattern '" + value + "' in " + path + ":" + std::to_string(lineNumber));
+            scenario.pattern = *preset;
+        }
+        else if (key == "pattern_emitters") scenario.patternEmitters = parseValue<int>(key, value, path, lineNumber);
+        else if (key == "headless") scenario.headless = parseValue<int>(key, value, path, lineNumber) != 0;
+        else throw ConfigurationError("Unknown key '" + key + "' in " + path + ":" + std::to_string(lineNumber));
+    });
+
+    if (scenario.berserkOrcs < 0 || scenario.mageOrcs < 0 || scenario.platforms < 0 ||
+        scenario.projectilesPerSecond < 0.f || scenario.durationSeconds <= 0.f ||
+        scenario.playerProjectileShare < 0.f || scenario.playerProjectileShare > 1.f || scenario.maxAiUpdatesPerTick < 1 || scenario.particleBudget < 0 || scenario.patternEmitters < 0) {
+        throw ConfigurationError("Out of range value in stress scenario " + path);
+    }
+    return scenario;
+}
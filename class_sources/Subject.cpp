@@ -1,20 +1,10 @@
-#include <vector>
-#include <algorithm>
-#include "../class_headers/Observer.h"
 #include "../class_headers/GameEvents.h"
 #include "../class_headers/Subject.h"
+#include "../class_headers/EventBus.h"
 
-void Subject::addObserver(Observer *observer) {
-    if (std::find(observers.begin(), observers.end(), observer) == observers.end()) {
-        observers.push_back(observer);
-    } // check for duplicates
-}
-
-void Subject::removeObserver(Observer *observer) {
-    observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
-}
+void Subject::setEventBus(EventBus* bus) { eventBus = bus; }
 
-void Subject::notifyObservers(GameEvent event) {
-    for (Observer* observer : observers)
-        if (observer) observer->onNotify(event);
+// queue the event, observers receive it on the next EventBus::dispatch
+void Subject::notifyObservers(GameEvent event, const sf::Vector2f& position, int entityId) const {
+    if (eventBus) eventBus->post(event, entityId, position);
 }
@@ -0,0 +1,43 @@
+#include "../class_headers/TextureCache.h"
+#include "../class_headers/GameExceptions.h"
+#include <filesystem>
+
+TextureCache& TextureCache::getInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+const sf::Texture& TextureCache::get(const std::string& path) {
+    std::lock_guard lock(mutex);
+    auto it = textures.find(path);
+    if (it != textures.end()) return *it->second;
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        throw ResourceLoadError("Texture", path, "Failed in TextureCache::get");
+    }
+    texture->setSmooth(false); // pixel art
+    return *textures.emplace(path, std::move(texture)).first->second;
+}
+
+bool TextureCache::contains(const std::string& path) const {
+    std::lock_guard lock(mutex);
+    return textures.contains(path);
+}
+
+sf::Texture* TextureCache::reload(const std::string& path, const sf::Image& image) {
+    std::lock_guard lock(mutex);
+    const std::filesystem::path wanted = std::filesystem::path(path).lexically_normal();
+    for (auto& [key, texture] : textures) { // keys are spelled by whoever loaded first ("./assets/..." or "assets/...")
+        if (std::filesystem::path(key).lexically_normal() != wanted) continue;
+        if (!texture->loadFromImage(image)) throw ResourceLoadError("Texture", path, "Failed in TextureCache::reload");
+        texture->setSmooth(false);
+        return texture.get();
+    }
+    return nullptr;
+}
+
+std::size_t TextureCache::size() const {
+    std::lock_guard lock(mutex);
+    return textures.size();
+}
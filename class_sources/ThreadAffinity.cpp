@@ -0,0 +1,28 @@
+#include "../class_headers/ThreadAffinity.h"
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+bool ThreadAffinity::pinCurrentThread(unsigned int core) {
+    if (core >= coreCount()) return false;
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << core) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    return false; // macOS only has affinity hints, not pinning
+#endif
+}
+
+unsigned int ThreadAffinity::coreCount() {
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
@@ -0,0 +1,54 @@
+#include "../class_headers/UdpLink.h"
+#include "../class_headers/GameExceptions.h"
+#include <algorithm>
+#include <string>
+
+UdpLink::UdpLink(unsigned short localPort, const sf::IpAddress& remoteAddress, unsigned short remotePort,
+                 const LinkConditions& conditions) :
+    remoteAddress(remoteAddress),
+    remotePort(remotePort),
+    conditions(conditions),
+    rng(localPort) {
+    if (socket.bind(localPort) != sf::Socket::Done) {
+        throw ConfigurationError("Could not bind UDP port " + std::to_string(localPort));
+    }
+    socket.setBlocking(false);
+}
+
+void UdpLink::send(const sf::Packet& packet) {
+    if (conditions.lossRate > 0.f && std::uniform_real_distribution<float>(0.f, 1.f)(rng) < conditions.lossRate) {
+        ++packetsDropped;
+        return;
+    }
+    float delayMs = conditions.latencyMs;
+    if (conditions.jitterMs > 0.f) {
+        delayMs += std::uniform_real_distribution<float>(-conditions.jitterMs, conditions.jitterMs)(rng);
+    }
+    const auto delay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(std::max(0.f, delayMs)));
+    outgoing.push_back({Clock::now() + delay, packet});
+    flush();
+}
+
+void UdpLink::flush() {
+    const auto now = Clock::now();
+    auto isDue = [now](const DelayedPacket& delayed) { return delayed.due <= now; };
+    for (DelayedPacket& delayed : outgoing) {
+        if (!isDue(delayed)) continue;
+        socket.send(delayed.packet, remoteAddress, remotePort); // a full send buffer is just more loss
+        ++packetsSent;
+    }
+    std::erase_if(outgoing, isDue);
+}
+
+bool UdpLink::receive(sf::Packet& packet) {
+    sf::IpAddress sender;
+    unsigned short senderPort = 0;
+    while (socket.receive(packet, sender, senderPort) == sf::Socket::Done) {
+        if (sender == remoteAddress && senderPort == remotePort) return true; // only the configured peer, strays are dropped
+    }
+    return false;
+}
+
+std::size_t UdpLink::getPacketsSent() const { return packetsSent; }
+
+std::size_t UdpLink::getPacketsDropped() const { return packetsDropped; }
@@ -8,6 +8,9 @@
 #include "../class_headers/MagicProjectile.h"
 #include "../class_headers/Platform.h"
 #include "../class_headers/GameExceptions.h"
+#include "../class_headers/LevelSpec.h"
+#include "../class_headers/AllocationTracker.h"
+#include "../class_headers/EventBus.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
@@ -15,21 +18,37 @@
 #include <string>
 #include <algorithm>
 #include <stdexcept>
-
-World::World(sf::RenderWindow* win, std::unique_ptr<EntityFactory> factory, SoundManager* sndMgr) :
+#include <optional>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+
+World::World(sf::RenderWindow* win, std::unique_ptr<EntityFactory> factory, EventBus* bus) :
     window(win),
     entityFactory(std::move(factory)),
-    soundManagerPtr(sndMgr),
-    playerPtr(nullptr), mageOrcPtr(nullptr) {
+    entities(&worldArena),
+    playerProjectiles(&worldArena),
+    playerProjectileData(&worldArena),
+    enemyProjectiles(&worldArena),
+    enemyProjectileData(&worldArena),
+    spareProjectiles(&worldArena),
+    spareMagicProjectiles(&worldArena),
+    platforms(&worldArena),
+    eventBus(bus),
+    spawnCommands(4 * entityGrainSize) { // heap, workers write the lanes; room for a few commands per entity of a chunk
     if (!window) {
         throw ConfigurationError("World requires a valid RenderWindow pointer!");
     }
     if (!this->entityFactory) { // Check the member variable
         throw ConfigurationError("World requires a valid EntityFactory instance!");
     }
+    entityFactory->setMemoryResource(&worldArena);
     try {
         loadResources();
-        createInitialEntitiesAndPlayer();
+        createPlayer();
+        reset(LevelSpec::defaultLevel(window->getSize()));
         std::cout << "World initialized successfully." << std::endl;
     } catch (const GameError& e) {
         std::cerr << "FATAL ERROR during World construction: " << e.what() << std::endl;
@@ -43,11 +62,19 @@ World::World(sf::RenderWindow* win, std::unique_ptr<EntityFactory> factory, Soun
     }
 }
 
+World::~World() {
+    worldArena.beginRelease(); // members below destroy their objects without freeing them, the arena goes last in one piece
+}
+
 void World::loadResources() {
-    if (!backgroundTexture.loadFromFile("assets/backgrounds/background_1.png")) {
-        throw ResourceLoadError("Texture", "assets/backgrounds/background_1.png", "SFML loadFromFile failed for World background.");
+    if (!backgroundTexture.loadFromFile(backgroundPath)) {
+        throw ResourceLoadError("Texture", backgroundPath, "SFML loadFromFile failed for World background.");
     }
-    backgroundSprite.setTexture(backgroundTexture);
+    fitBackground();
+}
+
+void World::fitBackground() {
+    backgroundSprite.setTexture(backgroundTexture, true);
     sf::Vector2u textureSize = backgroundTexture.getSize();
     sf::Vector2u windowSize = window->getSize();
     float scaleX = static_cast<float>(windowSize.x) / static_cast<float>(textureSize.x);
@@ -60,177 +87,459 @@ void World::loadResources() {
     );
 }
 
-void World::createInitialEntitiesAndPlayer() {
-    platforms.emplace_back(600.f, 700.f, 300.f, 20.f);
-    platforms.emplace_back(700.f, 500.f, 400.f, 20.f);
-    platforms.emplace_back(300.f, 350.f, 250.f, 20.f);
+void World::createPlayer() {
+    try {
+        Player& player = Player::getInstance(window, "idle", "assets/player/Idle.png", 6, 0.1f, {200.f, playerGroundY()});
+        player.setEventBus(eventBus);
+        player.setSpawnBuffer(&spawnCommands);
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR creating Player singleton: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+void World::enableCoop() {
+    if (coopPlayer) return;
+    coopPlayer = Player::createCoopPartner(window, {280.f, playerGroundY()}, nullptr); // outlives reset(), so not in the arena
+    coopPlayer->setEventBus(eventBus);
+    coopPlayer->setSpawnBuffer(&spawnCommands);
+}
+
+bool World::hasCoop() const { return coopPlayer != nullptr; }
+
+void World::reset(const LevelSpec& level) {
+    SimClock::setNow(0.0); // same timeline on every run (and on every networked peer)
+
+    // everything of the last run lives in the arena: destroy it without per-object frees, then drop the arena's
+    // buffers at once. The containers are replaced, not cleared, so no buffer of the old run is kept
+    worldArena.beginRelease();
+    entities = decltype(entities)(&worldArena); // orcs are rebuilt below, their textures come from TextureCache
+    playerProjectiles = decltype(playerProjectiles)(&worldArena);
+    enemyProjectiles = decltype(enemyProjectiles)(&worldArena);
+    spareProjectiles = decltype(spareProjectiles)(&worldArena);
+    spareMagicProjectiles = decltype(spareMagicProjectiles)(&worldArena);
+    playerProjectileData = ProjectileArrays(&worldArena);
+    enemyProjectileData = ProjectileArrays(&worldArena);
+    platforms = decltype(platforms)(&worldArena);
+    worldArena.release();
+    movedPlayerProjectiles = 0;
+    movedEnemyProjectiles = 0;
+
+    entityTable.clear(); // every old handle goes stale, including the player's
+    spawnCommands.clear();
+    navGraphDirty = true;
+    simulationScheduler.setCursor(0);
+    for (const sf::FloatRect& rect : level.platforms) {
+        platforms.emplace_back(rect.left, rect.top, rect.width, rect.height);
+    }
+
+    Player& player = Player::getInstance(window);
+    player.reset(level.playerStart);
+    playerHandle = entityTable.insert(&player);
+    player.setHandle(playerHandle);
+    if (coopPlayer) {
+        coopPlayer->reset(level.playerStart + sf::Vector2f(80.f, 0.f));
+        coopPlayerHandle = entityTable.insert(coopPlayer.get());
+        coopPlayer->setHandle(coopPlayerHandle);
+    }
 
+    // use the factory INTERFACE methods for polymorphic creation
+    entities.reserve(level.berserkOrcs.size() + level.mageOrcs.size());
+    for (const sf::Vector2f& position : level.berserkOrcs) {
+        addEntity(entityFactory->makeBerserkOrc(window, position));
+    }
+    for (const sf::Vector2f& position : level.mageOrcs) {
+        std::unique_ptr<Entity> mageEntity = entityFactory->makeMageOrc(window, position);
+        // dynamic cast to get specific MageOrc pointer
+        if (auto* mage = dynamic_cast<MageOrc*>(mageEntity.get())) {
+            mage->setTarget(playerHandle);
+        } else if (mageEntity) {
+            std::cerr << "Warning: Failed to dynamic_cast created MageOrc entity from factory." << std::endl;
+        }
+        addEntity(std::move(mageEntity));
+    }
+    spawnCommands.ensureLanes(JobSystem::chunkCount(entities.size(), entityGrainSize)); // warm before the first tick
+}
+
+float World::playerGroundY() {
     constexpr float playerFrameH{128.f};
     constexpr float playerScaleY{2.0f};
     constexpr float playerSpriteOriginYRelToFrameTop{playerFrameH / 2.f};
     constexpr float playerCustomHitboxTopLocal = (playerFrameH * (2.f/5.f));
     constexpr float playerCustomHitboxHeightLocal = playerFrameH * (3.f/5.f);
     constexpr float groundY = 900.f;
-    float playerLocalHitboxBottomRelToFrameTop = playerCustomHitboxTopLocal + playerCustomHitboxHeightLocal;
-    float playerTargetY = groundY - (playerLocalHitboxBottomRelToFrameTop - playerSpriteOriginYRelToFrameTop) * playerScaleY;
-    sf::Vector2f playerStartPosition = { 200.f, playerTargetY };
-
-
-    try {
-        playerPtr = &Player::getInstance(window, "idle", "assets/player/Idle.png", 6, 0.1f, playerStartPosition);
-        playerPtr->addObserver(soundManagerPtr);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR creating Player singleton: " << e.what() << std::endl;
-        throw;
-    }
+    constexpr float playerLocalHitboxBottomRelToFrameTop = playerCustomHitboxTopLocal + playerCustomHitboxHeightLocal;
+    return groundY - (playerLocalHitboxBottomRelToFrameTop - playerSpriteOriginYRelToFrameTop) * playerScaleY;
+}
 
-    // Orc Y-Positioning
+float World::berserkOrcGroundY() {
+    constexpr float groundY = 900.f;
     constexpr float orcFrameH = 96.f;
     constexpr float orcScaleY = 2.0f;
     constexpr float orcHitboxHeightLocal = orcFrameH * 0.6f;
     constexpr float orcHitboxOffsetYLocal = orcFrameH * (1.0f - 0.6f);
     constexpr float orcLocalHitboxBottomRelToFrameTop = orcHitboxOffsetYLocal + orcHitboxHeightLocal;
     constexpr float orcSpriteOriginYRelToFrameTop = orcFrameH / 2.0f;
-    float orcTargetY = groundY - (orcLocalHitboxBottomRelToFrameTop - orcSpriteOriginYRelToFrameTop) * orcScaleY;
+    return groundY - (orcLocalHitboxBottomRelToFrameTop - orcSpriteOriginYRelToFrameTop) * orcScaleY;
+}
 
+Player* World::getPlayer() const {
+    return static_cast<Player*>(entityTable.get(playerHandle)); // playerHandle only ever refers to the Player
+}
 
-    // use the factory INTERFACE methods for polymorphic creation
-    entities.push_back(entityFactory->makeBerserkOrc(window, sf::Vector2f(500.f, orcTargetY)));
-    entities.push_back(entityFactory->makeBerserkOrc(window, sf::Vector2f(1200.f, orcTargetY)));
+Player* World::getCoopPlayer() const {
+    return coopPlayer ? static_cast<Player*>(entityTable.get(coopPlayerHandle)) : nullptr;
+}
 
-    sf::Vector2u windowSize = window->getSize();
-    sf::Vector2f mageStartPosition = { static_cast<float>(windowSize.x) - 150.f, static_cast<float>(windowSize.y) / 2.5f };
+bool World::anyPlayerAlive() const {
+    const Player* player = getPlayer();
+    const Player* coop = getCoopPlayer();
+    return (player && player->getHealthPoints() > 0) || (coop && coop->getHealthPoints() > 0);
+}
 
-    std::unique_ptr<Entity> mageEntity = entityFactory->makeMageOrc(window, mageStartPosition);
-    // dynamic cast to get specific MageOrc pointer
-    mageOrcPtr = dynamic_cast<MageOrc*>(mageEntity.get());
-    if (!mageOrcPtr && mageEntity) {
-        std::cerr << "Warning: Failed to dynamic_cast created MageOrc entity from factory." << std::endl;
-    }
-    entities.push_back(std::move(mageEntity));
+EntityHandle World::addEntity(std::unique_ptr<Entity> entity) {
+    if (!entity) return {};
+    EntityHandle entityHandle = entityTable.insert(entity.get());
+    entity->setHandle(entityHandle);
+    entity->setSpawnBuffer(&spawnCommands);
+    entities.push_back(std::move(entity));
+    return entityHandle;
 }
 
-void World::handleInput() const {
-    if (playerPtr && playerPtr->getHealthPoints() > 0) {
-        playerPtr->actions();
-    } // handle user input (actions of Player)
+void World::handleInput(const PlayerInput& first, const PlayerInput& second) const {
+    if (Player* player = getPlayer(); player && player->getHealthPoints() > 0) player->applyInput(first);
+    if (Player* coop = getCoopPlayer(); coop && coop->getHealthPoints() > 0) coop->applyInput(second);
+}
+
+void World::updatePlayer(Player* player) {
+    if (!player) return;
+    if (player->getHealthPoints() > 0) {
+        player->updater(platforms);
+    }
+    player->update();
 }
 
 void World::update(float dt) { // global update
-    sf::Vector2f currentPlayerPos = {0,0};
-    if (playerPtr) {
-        if (playerPtr->getHealthPoints() > 0) {
-            playerPtr->updater(platforms);
-        }
-        playerPtr->update();
-        currentPlayerPos = playerPtr->getPosition();
+    SimClock::advance(dt); // every entity timer reads this
+    {
+        AllocationScope allocationScope(AllocationTag::SIMULATION); // a rebuild, or the first query towards a span, fills caches
+        if (navGraphDirty) rebuildNavGraph();
+        planChases();
+        // lanes for the entity pass are added here, growing them inside the allocation-free scope below would count
+        // against it whenever the entity count crosses a chunk boundary
+        spawnCommands.ensureLanes(JobSystem::chunkCount(entities.size(), entityGrainSize));
     }
+    {
+        AllocationScope allocationScope(AllocationTag::SIMULATION, true); // steady state only touches existing state
+        updatePlayer(getPlayer());
+        updatePlayer(getCoopPlayer());
+
+        updateEntities(dt);
+        integrateProjectiles(playerProjectiles, playerProjectileData);
+        integrateProjectiles(enemyProjectiles, enemyProjectileData);
+        movedPlayerProjectiles = playerProjectileData.size();
+        movedEnemyProjectiles = enemyProjectileData.size();
+    }
+    {
+        AllocationScope allocationScope(AllocationTag::SPAWNING); // allocates until the pools are warm
+        flushSpawnCommands(); // player shots from handleInput and everything emitted in the passes above
+    }
+    if (anyPlayerAlive()) {
+        AllocationScope allocationScope(AllocationTag::COLLISION, true);
+        checkCollisions();
+    }
+    AllocationScope allocationScope(AllocationTag::SPAWNING); // removed entities go back to the pools
+    removeMarkedEntities();
+}
 
-    for (auto& entityPtr : entities) {
-        if (!entityPtr) continue;
-        if (auto* mage = dynamic_cast<MageOrc*>(entityPtr.get())) {
-            if (playerPtr) {
-                mage->updatePlayerPosition(&currentPlayerPos);
+void World::updateEntities(float dt) {
+    const std::size_t count = entities.size(); // update() has prepared a lane per chunk
+
+    // level of detail from the players' positions and the view, decided serially so the schedule is deterministic
+    std::pmr::vector<sf::Vector2f> playerPositions(&frameArena);
+    for (const Player* player : {getPlayer(), getCoopPlayer()}) {
+        if (player && player->getHealthPoints() > 0) playerPositions.push_back(player->getPosition());
+    }
+    const sf::View& view = window->getView();
+    const sf::FloatRect viewArea(view.getCenter() - view.getSize() / 2.f, view.getSize());
+    std::pmr::vector<UpdateMode> modes(&frameArena);
+    simulationScheduler.schedule(entities, playerPositions, viewArea, modes);
+
+    // each entity only touches its own state, spawns go to the chunk's lane
+    jobSystem.parallelFor(count, entityGrainSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        SpawnCommandBuffer::LaneScope lane(chunk);
+        for (std::size_t i = begin; i < end; ++i) {
+            Entity* entity = entities[i].get();
+            if (!entity) continue;
+            const float aiSeconds = simulationScheduler.consumeTime(entity->getLodState(), modes[i], dt);
+            if (modes[i] == UpdateMode::SKIP) continue;
+            if (modes[i] == UpdateMode::MOVE_ONLY) {
+                entity->stepMovement();
+                continue;
+            }
+            if (auto* mage = dynamic_cast<MageOrc*>(entity)) {
+                const Entity* target = entityTable.get(mage->getTarget()); // read-only lookup, safe from any worker
+                mage->updateTargetPosition(target ? std::optional(target->getPosition()) : std::nullopt);
+                mage->updater(aiSeconds);
+            } else if (auto* orc = dynamic_cast<BerserkOrc*>(entity)) {
+                orc->update();
             } else {
-                mage->updatePlayerPosition(nullptr);
+                entity->update();
             }
-            mage->updater(dt);
-        } else if (auto* orc = dynamic_cast<BerserkOrc*>(entityPtr.get())) {
-            orc->update();
-        } else { // for other entities like projectiles
-            entityPtr->update();
+        }
+    });
+}
+
+void World::rebuildNavGraph() {
+    constexpr float groundY = 900.f;
+    // orcs jump like the player does, the level is laid out for that jump
+    navGraph.build(platforms, groundY, static_cast<float>(window->getSize().x), Player::jumpPhysics(), BerserkOrc::navHalfWidth);
+    navGraphDirty = false;
+}
+
+void World::planChases() {
+    constexpr float aggroRadius{500.f};
+    constexpr int replanInterval{12}; // ticks between two plans of one orc; staggered by slot so a horde spreads its searches
+    constexpr float feetTolerance{4.f};
+
+    const Player* players[] = {getPlayer(), getCoopPlayer()};
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        auto* orc = dynamic_cast<BerserkOrc*>(entities[i].get());
+        if (!orc || orc->getHealthPoints() <= 0 || orc->isMarkedForRemoval() || !orc->dueForReplan(i, replanInterval)) continue;
+        const std::optional<std::int32_t> from = navGraph.spanBelow(orc->getFeet(), feetTolerance);
+        if (!from) continue;
+        const NavSpan& span = navGraph.getSpan(*from);
+
+        const Player* target = nullptr; // nearest live player in range
+        float bestDistanceSq = aggroRadius * aggroRadius;
+        for (const Player* player : players) {
+            if (!player || player->getHealthPoints() <= 0) continue;
+            const sf::Vector2f offset = player->getPosition() - orc->getPosition();
+            const float distanceSq = offset.x * offset.x + offset.y * offset.y;
+            if (distanceSq < bestDistanceSq) {
+                bestDistanceSq = distanceSq;
+                target = player;
+            }
+        }
+        if (!target) {
+            orc->stopChasing(span.left, span.right);
+            continue;
+        }
+
+        const sf::FloatRect targetBounds = target->getCollisionBounds();
+        const sf::Vector2f targetFeet(targetBounds.left + targetBounds.width / 2.f, targetBounds.top + targetBounds.height);
+        const std::optional<std::int32_t> goal = navGraph.spanBelow(targetFeet, feetTolerance);
+        const std::int32_t link = goal ? navGraph.nextLink(*from, *goal, &frameArena) : NavGraph::unreachable;
+        if (link == NavGraph::sameSpan) {
+            orc->chaseTo(targetFeet.x, span.left, span.right);
+        } else if (link == NavGraph::unreachable) {
+            orc->stopChasing(span.left, span.right);
+        } else {
+            orc->chaseVia(navGraph.getLink(link), span.left, span.right);
         }
     }
+}
 
-    // spawn all projectiles
-    spawnPlayerProjectiles();
-    spawnEnemyProjectiles();
+template <typename T>
+void World::addProjectile(std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data, std::unique_ptr<T> bullet) {
+    sf::FloatRect bounds = bullet->getVisualBounds();
+    sf::Vector2f velocity = bullet->getVelocity();
+    float halfWidth = bounds.width / 2.f;
+    float halfHeight = bounds.height / 2.f;
+    data.push(bounds.left + halfWidth, bounds.top + halfHeight, velocity.x, velocity.y, halfWidth, halfHeight);
+    bullets.push_back(std::move(bullet));
+}
 
-    if (playerPtr && playerPtr->getHealthPoints() > 0) {
-        checkCollisions();
+template <typename T>
+void World::integrateProjectiles(std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data) {
+    const sf::Vector2u windowSize = window->getSize(); // once per pass instead of once per bullet
+    const auto areaWidth = static_cast<float>(windowSize.x);
+    const auto areaHeight = static_cast<float>(windowSize.y);
+
+    jobSystem.parallelFor(data.size(), projectileGrainSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        const std::size_t count = end - begin;
+        ProjectileKernels::integrate(data.x.data() + begin, data.y.data() + begin, data.vx.data() + begin, data.vy.data() + begin, count);
+        ProjectileKernels::flagOutOfBounds(data.x.data() + begin, data.y.data() + begin,
+                                           data.halfWidth.data() + begin, data.halfHeight.data() + begin,
+                                           count, areaWidth, areaHeight, data.offScreen.data() + begin);
+        for (std::size_t i = begin; i < end; ++i) { // sprites only follow the arrays for drawing
+            bullets[i]->applyIntegratedPosition(data.x[i], data.y[i]);
+            if (data.offScreen[i]) bullets[i]->markForRemoval();
+        }
+    });
+}
+
+template <typename T>
+std::unique_ptr<T> World::acquireProjectile(std::pmr::vector<std::unique_ptr<T>>& spares, const SpawnCommand& command) {
+    if (spares.empty()) { // static template method from ConcreteEntityFactory
+        return ConcreteEntityFactory::create<T>(&worldArena, window, command.position.x, command.position.y, command.direction.x, command.direction.y, command.speed);
     }
-    removeMarkedEntities();
+    std::unique_ptr<T> bullet = std::move(spares.back());
+    spares.pop_back();
+    bullet->reset(command.position.x, command.position.y, command.direction.x, command.direction.y, command.speed);
+    return bullet;
 }
 
-void World::spawnPlayerProjectiles() {
-    if (playerPtr && playerPtr->wantsToShootProjectile()) {
-        ProjectileSpawnInfo spawnInfo = playerPtr->getProjectileSpawnDetails();
-        try { // static template method from ConcreteEntityFactory
-            entities.push_back(ConcreteEntityFactory::create<Projectile>(window, spawnInfo.position.x, spawnInfo.position.y, spawnInfo.direction.x, spawnInfo.direction.y, spawnInfo.speed));
-        } catch (const GameError& e) {
-            std::cerr << "Error spawning Player Projectile: " << e.what() << std::endl;
+template <typename T>
+void World::compactProjectiles(std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data, std::pmr::vector<std::unique_ptr<T>>& spares) {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < bullets.size(); ++i) { // stable, arrays stay index-aligned with the bullets
+        if (!bullets[i]) continue;
+        if (bullets[i]->isMarkedForRemoval()) {
+            spares.push_back(std::move(bullets[i])); // reused by the next spawn of this kind
+            continue;
+        }
+        if (kept != i) {
+            bullets[kept] = std::move(bullets[i]);
+            data.moveElement(i, kept);
         }
+        ++kept;
     }
+    bullets.resize(kept);
+    data.resize(kept);
 }
 
-void World::spawnEnemyProjectiles() {
-    std::vector<std::unique_ptr<Entity>> newProjectiles;
-    if (mageOrcPtr && !mageOrcPtr->isMarkedForRemoval()) {
-        std::vector<MagicProjectileSpawnInfo> spawnQueue = mageOrcPtr->getProjectilesToSpawn();
-        for (const auto& spawnInfo : spawnQueue) {
-            try { // static template method from ConcreteEntityFactory
-                newProjectiles.push_back(ConcreteEntityFactory::create<MagicProjectile>(window, spawnInfo.position.x, spawnInfo.position.y, spawnInfo.direction.x, spawnInfo.direction.y, spawnInfo.speed));
-            } catch (const GameError& e) {
-                std::cerr << "Error spawning MagicProjectile: " << e.what() << std::endl;
+void World::flushSpawnCommands() {
+    if (spawnCommands.totalCount() == 0) return;
+
+    // one capacity check per destination, then plain appends
+    const std::size_t playerShots = spawnCommands.countOf(SpawnKind::PLAYER_PROJECTILE);
+    const std::size_t enemyShots = spawnCommands.countOf(SpawnKind::MAGIC_PROJECTILE);
+    playerProjectiles.reserve(playerProjectiles.size() + playerShots);
+    playerProjectileData.reserve(playerProjectileData.size() + playerShots);
+    enemyProjectiles.reserve(enemyProjectiles.size() + enemyShots);
+    enemyProjectileData.reserve(enemyProjectileData.size() + enemyShots);
+    entities.reserve(entities.size() + spawnCommands.totalCount() - playerShots - enemyShots);
+
+    spawnCommands.forEach([this](const SpawnCommand& command) { // lane order == entity order, same as a serial pass
+        try {
+            switch (command.kind) {
+                case SpawnKind::PLAYER_PROJECTILE:
+                    addProjectile(playerProjectiles, playerProjectileData, acquireProjectile(spareProjectiles, command));
+                    break;
+                case SpawnKind::MAGIC_PROJECTILE:
+                    addProjectile(enemyProjectiles, enemyProjectileData, acquireProjectile(spareMagicProjectiles, command));
+                    break;
+                case SpawnKind::BERSERK_ORC:
+                    addEntity(entityFactory->makeBerserkOrc(window, command.position));
+                    break;
+                case SpawnKind::MAGE_ORC: {
+                    std::unique_ptr<Entity> mageEntity = entityFactory->makeMageOrc(window, command.position);
+                    if (auto* mage = dynamic_cast<MageOrc*>(mageEntity.get())) mage->setTarget(playerHandle);
+                    addEntity(std::move(mageEntity));
+                    break;
+                }
             }
+        } catch (const GameError& e) {
+            std::cerr << "Error executing spawn command " << static_cast<int>(command.kind) << ": " << e.what() << std::endl;
         }
-    }
-    if (!newProjectiles.empty()) {
-        std::ranges::move(newProjectiles, std::back_inserter(entities));
-    }
+    });
+    spawnCommands.clear(); // keeps every lane's memory for the next tick
 }
 
-void World::checkCollisions() {
-    if (playerPtr->getHealthPoints() <= 0) return;
+bool World::CollisionTarget::isDead() const { return orc ? orc->getHealthPoints() <= 0 : mage->getHealthPoints() <= 0; }
 
-    sf::FloatRect playerHitbox = playerPtr->getCollisionBounds();
+void World::CollisionTarget::takeDamage() const {
+    if (orc) orc->takeDamage(); else mage->takeDamage();
+}
 
+void World::checkCollisions() {
+    // one dynamic_cast per enemy per tick, the list only lives until the frame arena is reset
+    std::pmr::vector<CollisionTarget> targets(&frameArena);
+    targets.reserve(entities.size());
     for (const auto& entityPtr : entities) {
         if (!entityPtr) continue;
-
-        // Use auto for dynamic_cast results
-        if (auto* orc = dynamic_cast<BerserkOrc*>(entityPtr.get())) { // Requires BerserkOrc.h
-            if (!orc->isMarkedForRemoval() && playerHitbox.intersects(orc->getCollisionBounds())) {
-                playerPtr->takeDamage();
-            }
-        } else if (auto* mage = dynamic_cast<MageOrc*>(entityPtr.get())) { // Requires MageOrc.h
-            if (!mage->isMarkedForRemoval() && playerHitbox.intersects(mage->getCollisionBounds())) {
-                playerPtr->takeDamage();
-            }
-        } else if (auto* magicBullet = dynamic_cast<MagicProjectile*>(entityPtr.get())) { // Requires MagicProjectile.h
-            if (!magicBullet->isMarkedForRemoval() && playerHitbox.intersects(magicBullet->getVisualBounds())) {
-                playerPtr->takeDamage();
-                magicBullet->markForRemoval();
-            }
+        if (auto* orc = dynamic_cast<BerserkOrc*>(entityPtr.get())) {
+            if (!orc->isMarkedForRemoval()) targets.push_back({orc, nullptr, orc->getCollisionBounds()});
+        } else if (auto* mage = dynamic_cast<MageOrc*>(entityPtr.get())) {
+            if (!mage->isMarkedForRemoval() && mage->getHealthPoints() > 0) targets.push_back({nullptr, mage, mage->getCollisionBounds()});
         }
     }
 
-    for (auto& projectileEntityPtr : entities) {
-        if (!projectileEntityPtr) continue;
+    constexpr float miss = std::numeric_limits<float>::infinity();
+    constexpr std::uint32_t noTarget = std::numeric_limits<std::uint32_t>::max();
 
-        if (auto* playerBullet = dynamic_cast<Projectile*>(projectileEntityPtr.get())) { // Requires Projectile.h
-            if (playerBullet->isMarkedForRemoval()) continue;
+    // contact damage, then every enemy bullet goes to the player its step reached first (slot order on a tie)
+    Player* players[] = {getPlayer(), getCoopPlayer()};
+    std::pmr::vector<float> earliest(enemyProjectiles.size(), miss, &frameArena);
+    std::pmr::vector<std::uint32_t> hitPlayer(enemyProjectiles.size(), noTarget, &frameArena);
+    for (std::uint32_t slot = 0; slot < std::size(players); ++slot) {
+        Player* player = players[slot];
+        if (!player || player->getHealthPoints() <= 0) continue;
 
-            sf::FloatRect projBounds = playerBullet->getVisualBounds();
+        sf::FloatRect playerHitbox = player->getCollisionBounds();
 
-            for (auto& targetEntityPtr : entities) {
-                if (!targetEntityPtr || targetEntityPtr.get() == playerBullet) continue;
+        for (const CollisionTarget& target : targets) {
+            if (playerHitbox.intersects(target.bounds)) {
+                player->takeDamage();
+            }
+        }
 
-                if (auto* orc = dynamic_cast<BerserkOrc*>(targetEntityPtr.get())) { // Requires BerserkOrc.h
-                    if (!orc->isMarkedForRemoval() && projBounds.intersects(orc->getCollisionBounds())) {
-                        playerBullet->markForRemoval();
-                        orc->takeDamage();
-                        break;
-                    }
-                } else if (auto* mage = dynamic_cast<MageOrc*>(targetEntityPtr.get())) { // Requires MageOrc.h
-                    if (!mage->isMarkedForRemoval() && projBounds.intersects(mage->getCollisionBounds())) {
-                        playerBullet->markForRemoval();
-                        mage->takeDamage();
-                        break;
-                    }
+        projectileHitTimes(enemyProjectileData, movedEnemyProjectiles, playerHitbox);
+        for (std::size_t i = 0; i < enemyProjectiles.size(); ++i) {
+            if (enemyProjectileData.hitTimes[i] < earliest[i]) {
+                earliest[i] = enemyProjectileData.hitTimes[i];
+                hitPlayer[i] = slot;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < enemyProjectiles.size(); ++i) {
+        if (hitPlayer[i] == noTarget || enemyProjectiles[i]->isMarkedForRemoval()) continue;
+        players[hitPlayer[i]]->takeDamage();
+        enemyProjectiles[i]->markForRemoval();
+    }
+
+    // player bullets: each goes to the target its step reached first, not the first one in entity order. A bullet whose
+    // target was killed by an earlier bullet of the same tick tries again against the targets still alive
+    earliest.assign(playerProjectiles.size(), miss);
+    std::pmr::vector<std::uint32_t> hitTarget(playerProjectiles.size(), noTarget, &frameArena);
+    std::pmr::vector<std::uint8_t> unresolved(playerProjectiles.size(), 1, &frameArena);
+    bool retry = true;
+    while (retry) {
+        retry = false;
+        for (std::uint32_t t = 0; t < targets.size(); ++t) {
+            if (targets[t].isDead()) continue;
+            projectileHitTimes(playerProjectileData, movedPlayerProjectiles, targets[t].bounds);
+            for (std::size_t i = 0; i < playerProjectiles.size(); ++i) {
+                if (unresolved[i] && playerProjectileData.hitTimes[i] < earliest[i]) {
+                    earliest[i] = playerProjectileData.hitTimes[i];
+                    hitTarget[i] = t;
                 }
             }
         }
+        for (std::size_t i = 0; i < playerProjectiles.size(); ++i) { // bullet order decides who lands the killing hit
+            if (!unresolved[i]) continue;
+            unresolved[i] = 0;
+            if (hitTarget[i] == noTarget || playerProjectiles[i]->isMarkedForRemoval()) continue;
+            const CollisionTarget& target = targets[hitTarget[i]];
+            if (target.isDead()) { // flies on, every target is tested again in the next round
+                unresolved[i] = 1;
+                earliest[i] = miss;
+                hitTarget[i] = noTarget;
+                retry = true;
+                continue;
+            }
+            playerProjectiles[i]->markForRemoval();
+            target.takeDamage();
+            if (eventBus) eventBus->post(GameEvent::PROJECTILE_HIT, -1, {playerProjectileData.x[i], playerProjectileData.y[i]});
+            if (target.isDead() && eventBus) { // the killing hit
+                eventBus->post(GameEvent::ENEMY_DIED, -1, {target.bounds.left + target.bounds.width / 2.f,
+                                                           target.bounds.top + target.bounds.height / 2.f});
+            }
+        }
+    }
+}
+
+void World::projectileHitTimes(ProjectileArrays& data, std::size_t moved, const sf::FloatRect& target) {
+    // bullets that moved this tick are tested along their whole step; ones spawned after the move only where they are,
+    // sweeping them backwards would test ground they never covered, so they hit at time 0 or not at all
+    ProjectileKernels::sweepTarget(data.x.data(), data.y.data(), data.vx.data(), data.vy.data(),
+                                   data.halfWidth.data(), data.halfHeight.data(), moved, target, data.hitTimes.data());
+    ProjectileKernels::overlapTarget(data.x.data() + moved, data.y.data() + moved,
+                                     data.halfWidth.data() + moved, data.halfHeight.data() + moved,
+                                     data.size() - moved, target, data.hits.data() + moved);
+    for (std::size_t i = moved; i < data.size(); ++i) {
+        data.hitTimes[i] = data.hits[i] ? 0.f : std::numeric_limits<float>::infinity();
     }
 }
 
@@ -243,49 +552,274 @@ void World::updateHealthDisplay() {
 }
 
 void World::removeMarkedEntities() {
-    entities.erase(
-        std::ranges::remove_if(entities,
-               [](const std::unique_ptr<Entity>& entity) {
-                   if (!entity) return true;
-                   if (auto* p = dynamic_cast<Projectile*>(entity.get())) return p->isMarkedForRemoval();
-                   if (auto* mp = dynamic_cast<MagicProjectile*>(entity.get())) return mp->isMarkedForRemoval();
-                   if (auto* bo = dynamic_cast<BerserkOrc*>(entity.get())) return bo->isMarkedForRemoval();
-                   if (auto* mo = dynamic_cast<MageOrc*>(entity.get())) return mo->isMarkedForRemoval();
-                   return false;
-               }).begin(),
-        entities.end()
-    );
-
-    if (mageOrcPtr) {
-        bool found = false;
-        for (const auto& entity : entities) {
-            if (entity.get() == mageOrcPtr) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            mageOrcPtr = nullptr;
-        }
+    auto isMarked = [](const std::unique_ptr<Entity>& entity) {
+        if (!entity) return true;
+        if (auto* bo = dynamic_cast<BerserkOrc*>(entity.get())) return bo->isMarkedForRemoval();
+        if (auto* mo = dynamic_cast<MageOrc*>(entity.get())) return mo->isMarkedForRemoval();
+        return false;
+    };
+    for (const auto& entity : entities) { // stale handles are caught in O(1) from now on
+        if (entity && isMarked(entity)) entityTable.remove(entity->getHandle());
     }
+    entities.erase(std::ranges::remove_if(entities, isMarked).begin(), entities.end());
+    compactProjectiles(playerProjectiles, playerProjectileData, spareProjectiles);
+    compactProjectiles(enemyProjectiles, enemyProjectileData, spareMagicProjectiles);
+}
+
+void World::draw() { draw(*window); }
+
+void World::draw(sf::RenderTarget& target) {
+    RenderStats discarded;
+    RenderStatsTarget counted(target, discarded);
+    draw(counted);
+}
+
+void World::draw(RenderStatsTarget& target) {
+    drawScratch.clear();
+    buildRenderSnapshot(drawScratch);
+    AllocationScope allocationScope(AllocationTag::RENDERING);
+    drawScratch.drawTo(target);
 }
 
-void World::draw() {
-    window->draw(backgroundSprite);
+void World::buildRenderSnapshot(RenderSnapshot& out) const {
+    AllocationScope allocationScope(AllocationTag::RENDER_BUILD, true); // the snapshot keeps its capacity between frames
+    out.setLayer(RenderLayer::BACKGROUND);
+    out.addSprite(backgroundSprite);
+    out.setLayer(RenderLayer::PLATFORMS);
     for (const auto& platform : platforms) {
-        platform.draw(*window);
+        platform.appendRenderItems(out);
     }
+    out.setLayer(RenderLayer::ENTITIES);
     for (const auto& entity : entities) {
-        if (entity) entity->draw();
+        if (entity) entity->appendRenderItems(out);
     }
-    if (playerPtr) {
-        playerPtr->draw();
+    out.setLayer(RenderLayer::PROJECTILES);
+    for (const auto& bullet : playerProjectiles) bullet->appendRenderItems(out);
+    for (const auto& bullet : enemyProjectiles) bullet->appendRenderItems(out);
+    out.setLayer(RenderLayer::ENTITIES);
+    if (const Player* coop = getCoopPlayer()) {
+        coop->appendRenderItems(out);
+    }
+    if (const Player* player = getPlayer()) {
+        player->appendRenderItems(out);
+    }
+}
+
+std::size_t World::onTextureReloaded(const sf::Texture& texture) {
+    std::size_t patched = 0;
+    for (const auto& entity : entities) {
+        if (entity && entity->onTextureReloaded(texture)) ++patched;
+    }
+    for (const auto& bullet : playerProjectiles) patched += bullet->onTextureReloaded(texture);
+    for (const auto& bullet : enemyProjectiles) patched += bullet->onTextureReloaded(texture);
+    for (const auto& bullet : spareProjectiles) patched += bullet->onTextureReloaded(texture);
+    for (const auto& bullet : spareMagicProjectiles) patched += bullet->onTextureReloaded(texture);
+    if (Player* player = getPlayer()) patched += player->onTextureReloaded(texture);
+    if (Player* coop = getCoopPlayer()) patched += coop->onTextureReloaded(texture);
+    return patched;
+}
+
+void World::reloadBackground(const sf::Image& image) {
+    if (!backgroundTexture.loadFromImage(image)) {
+        throw ResourceLoadError("Texture", backgroundPath, "SFML loadFromImage failed for World background reload.");
+    }
+    fitBackground(); // the new image may have another size
+}
+
+void World::applyLayout(const LevelSpec& level) {
+    platforms.clear();
+    for (const sf::FloatRect& rect : level.platforms) {
+        platforms.emplace_back(rect.left, rect.top, rect.width, rect.height);
+    }
+    rebuildNavGraph(); // now, so the orcs below can be put on the new spans
+    constexpr float feetTolerance{4.f};
+    for (const auto& entity : entities) { // chases planned on the old graph are dropped, the next plan uses the new one
+        auto* orc = dynamic_cast<BerserkOrc*>(entity.get());
+        if (!orc || !orc->isChasing() || orc->isAirborne()) continue;
+        if (const std::optional<std::int32_t> span = navGraph.spanBelow(orc->getFeet(), feetTolerance)) {
+            orc->stopChasing(navGraph.getSpan(*span).left, navGraph.getSpan(*span).right);
+        }
     }
 }
 
 bool World::isGameOver() const {
-    if (playerPtr) {
-        return playerPtr->getHealthPoints() <= 0;
+    return !anyPlayerAlive(); // in co-op the run lasts while either player stands
+}
+
+void World::queueSpawn(const SpawnCommand& command) {
+    spawnCommands.ensureLanes(1);
+    spawnCommands.push(command); // called between ticks, lands in lane 0
+}
+
+void World::addPlatform(float x, float y, float width, float height) {
+    platforms.emplace_back(x, y, width, height);
+    navGraphDirty = true; // rebuilt once by the next update, however many platforms are added
+}
+
+void World::setPlayerInvulnerable(bool invulnerable) const {
+    if (Player* player = getPlayer()) player->setInvulnerable(invulnerable);
+    if (Player* coop = getCoopPlayer()) coop->setInvulnerable(invulnerable);
+}
+
+FrameArena& World::getFrameArena() { return frameArena; }
+
+const WorldArena& World::getWorldArena() const { return worldArena; }
+
+void World::setSimulationLod(const SimulationLodConfig& config) { simulationScheduler.setConfig(config); }
+
+const SimulationLodStats& World::getSimulationLodStats() const { return simulationScheduler.getLastStats(); }
+
+const NavGraphStats& World::getNavGraphStats() const { return navGraph.getStats(); }
+
+std::size_t World::getEntityCount() const {
+    return entityTable.size() + playerProjectiles.size() + enemyProjectiles.size();
+}
+
+
+namespace {
+    constexpr std::uint32_t snapshotMagic{0x4E534C54}; // "TLSN"
+    constexpr std::uint32_t snapshotVersion{4}; // 2: co-op player, 3: simulation LOD state, 4: berserk orc pursuit
+}
+
+void World::saveProjectiles(SnapshotWriter& writer, const ProjectileArrays& data) {
+    // the arrays are the simulation state, sprites are rebuilt from them
+    writer.writeArray(data.x);
+    writer.writeArray(data.y);
+    writer.writeArray(data.vx);
+    writer.writeArray(data.vy);
+    writer.writeArray(data.halfWidth);
+    writer.writeArray(data.halfHeight);
+}
+
+template <typename T>
+void World::loadProjectiles(SnapshotReader& reader, std::pmr::vector<std::unique_ptr<T>>& bullets, ProjectileArrays& data, std::pmr::vector<std::unique_ptr<T>>& spares) {
+    reader.readArray(data.x);
+    reader.readArray(data.y);
+    reader.readArray(data.vx);
+    reader.readArray(data.vy);
+    reader.readArray(data.halfWidth);
+    reader.readArray(data.halfHeight);
+    const std::size_t count = data.x.size();
+    if (data.y.size() != count || data.vx.size() != count || data.vy.size() != count ||
+        data.halfWidth.size() != count || data.halfHeight.size() != count) {
+        throw InvalidStateError("Snapshot projectile arrays have different lengths");
+    }
+    data.offScreen.assign(count, 0);
+    data.hits.assign(count, 0);
+    data.hitTimes.assign(count, 0.f);
+
+    while (bullets.size() > count) { // surplus back to the pool
+        spares.push_back(std::move(bullets.back()));
+        bullets.pop_back();
+    }
+    bullets.reserve(count);
+    while (bullets.size() < count) {
+        bullets.push_back(acquireProjectile(spares, SpawnCommand{SpawnKind::MAGIC_PROJECTILE, {0.f, 0.f}, {1.f, 0.f}, 1.f}));
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        bullets[i]->reset(data.x[i], data.y[i], data.vx[i], data.vy[i], std::hypot(data.vx[i], data.vy[i]));
+    }
+}
+
+void World::registerEntities() {
+    entityTable.clear();
+    spawnCommands.clear();
+    Player& player = Player::getInstance(window);
+    playerHandle = entityTable.insert(&player);
+    player.setHandle(playerHandle);
+    if (coopPlayer) {
+        coopPlayerHandle = entityTable.insert(coopPlayer.get());
+        coopPlayer->setHandle(coopPlayerHandle);
+    }
+    for (auto& entity : entities) {
+        EntityHandle entityHandle = entityTable.insert(entity.get());
+        entity->setHandle(entityHandle);
+        entity->setSpawnBuffer(&spawnCommands);
+        if (auto* mage = dynamic_cast<MageOrc*>(entity.get())) mage->setTarget(playerHandle);
+    }
+}
+
+void World::saveSnapshot(std::vector<std::byte>& out) const {
+    const Player* player = getPlayer();
+    if (!player) throw InvalidStateError("World::saveSnapshot without a registered player");
+
+    out.clear();
+    SnapshotWriter writer(out);
+    writer.write(snapshotMagic);
+    writer.write(snapshotVersion);
+    writer.write(SimClock::getNow());
+    player->saveState(writer);
+    writer.write(coopPlayer != nullptr);
+    if (coopPlayer) coopPlayer->saveState(writer);
+
+    writer.write(static_cast<std::uint64_t>(simulationScheduler.getCursor()));
+    writer.write(static_cast<std::uint32_t>(entities.size()));
+    for (const auto& entity : entities) {
+        const SpawnKind kind = dynamic_cast<const MageOrc*>(entity.get()) ? SpawnKind::MAGE_ORC : SpawnKind::BERSERK_ORC;
+        writer.write(kind);
+        entity->saveState(writer);
     }
-    return true;
-}
\ No newline at end of file
+    saveProjectiles(writer, playerProjectileData);
+    saveProjectiles(writer, enemyProjectileData);
+}
+
+void World::loadSnapshot(std::span<const std::byte> blob) {
+    // entities are read in place, so a blob that breaks halfway would leave a half-restored world and stale handles;
+    // the current state is kept aside (capacity reused) and put back in that case
+    const bool backedUp = getPlayer() != nullptr;
+    if (backedUp) saveSnapshot(loadBackup);
+    try {
+        readSnapshot(blob);
+    } catch (...) { // a corrupt blob, or the factory failing to rebuild an entity
+        if (backedUp) {
+            readSnapshot(loadBackup); // written by saveSnapshot just now, matches this World
+        } else {
+            std::erase(entities, nullptr);
+            registerEntities(); // at least no handle points to a destroyed entity
+        }
+        throw;
+    }
+}
+
+void World::readSnapshot(std::span<const std::byte> blob) {
+    SnapshotReader reader(blob);
+    if (reader.read<std::uint32_t>() != snapshotMagic || reader.read<std::uint32_t>() != snapshotVersion) {
+        throw InvalidStateError("Not a snapshot of this World version");
+    }
+    SimClock::setNow(reader.read<double>());
+
+    Player& player = Player::getInstance(window);
+    player.loadState(reader);
+    if (reader.read<bool>() != (coopPlayer != nullptr)) {
+        throw InvalidStateError("Snapshot co-op mode does not match this World");
+    }
+    if (coopPlayer) coopPlayer->loadState(reader);
+
+    simulationScheduler.setCursor(static_cast<std::size_t>(reader.read<std::uint64_t>()));
+
+    // entities whose kind matches the slot are reused, the rest are rebuilt through the factory
+    const auto count = reader.read<std::uint32_t>();
+    entities.resize(std::min<std::size_t>(entities.size(), count));
+    entities.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const auto kind = reader.read<SpawnKind>();
+        const bool isMage = kind == SpawnKind::MAGE_ORC;
+        if (kind != SpawnKind::MAGE_ORC && kind != SpawnKind::BERSERK_ORC) {
+            throw InvalidStateError("Unknown entity kind in snapshot");
+        }
+        if (i < entities.size() && isMage != (dynamic_cast<MageOrc*>(entities[i].get()) != nullptr)) {
+            entities[i].reset();
+        }
+        if (i >= entities.size()) entities.emplace_back();
+        if (!entities[i]) {
+            entities[i] = isMage ? entityFactory->makeMageOrc(window, {0.f, 0.f}) : entityFactory->makeBerserkOrc(window, {0.f, 0.f});
+        }
+        entities[i]->loadState(reader);
+    }
+
+    registerEntities(); // handles are not part of the blob
+
+    loadProjectiles(reader, playerProjectiles, playerProjectileData, spareProjectiles);
+    loadProjectiles(reader, enemyProjectiles, enemyProjectileData, spareMagicProjectiles);
+    if (!reader.atEnd()) throw InvalidStateError("Trailing data after snapshot");
+}
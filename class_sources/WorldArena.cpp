@@ -0,0 +1,59 @@
+#include "../class_headers/WorldArena.h"
+#include <algorithm>
+#include <iostream>
+
+void* WorldArena::HeapResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    held.fetch_add(bytes, std::memory_order_relaxed);
+    return pointer;
+}
+
+void WorldArena::HeapResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    held.fetch_sub(bytes, std::memory_order_relaxed);
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+WorldArena::WorldArena() : chunks(&heap), pools(std::pmr::pool_options{0, largestPooledBlock}, &chunks) {}
+
+void* WorldArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // the pools would take anything bigger from the monotonic buffer, where a regrown vector's old storage stays
+    void* pointer = bytes > largestPooledBlock ? heap.allocate(bytes, alignment) : pools.allocate(bytes, alignment);
+    inUse += bytes;
+    runPeak = std::max(runPeak, inUse);
+    return pointer;
+}
+
+void WorldArena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    if (bytes > largestPooledBlock) { // not in any buffer release() drops, freed even while releasing
+        if (!releasing) inUse -= bytes;
+        heap.deallocate(pointer, bytes, alignment);
+        return;
+    }
+    if (releasing) return; // release() takes the whole buffer
+    inUse -= bytes;
+    pools.deallocate(pointer, bytes, alignment);
+}
+
+void WorldArena::beginRelease() { releasing = true; }
+
+void WorldArena::release() {
+    pools.release(); // the pool's chunks go back to the monotonic buffer, which ignores frees
+    chunks.release(); // one heap free per buffer
+    releasing = false;
+    inUse = 0;
+    runPeak = 0;
+}
+
+WorldArenaStats WorldArena::getStats() const {
+    WorldArenaStats stats;
+    stats.bytesInUse = inUse;
+    stats.runPeakBytes = runPeak;
+    stats.heapBytes = heap.held.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WorldArena::printSummary() const {
+    const WorldArenaStats stats = getStats();
+    std::cout << "World arena: " << stats.runPeakBytes / 1024 << " KiB peak this run, " << stats.bytesInUse / 1024
+              << " KiB in use, " << stats.heapBytes / 1024 << " KiB held from the heap\n";
+}
@@ -32,6 +32,18 @@ function(set_compiler_flags)
             target_compile_options(${TARGET_NAME} PRIVATE -Wall -Wextra -pedantic)
         endif()
 
+        if(USE_AVX2)
+            if(MSVC)
+                target_compile_options(${TARGET_NAME} PRIVATE /arch:AVX2)
+            else()
+                target_compile_options(${TARGET_NAME} PRIVATE -mavx2)
+            endif()
+        endif()
+
+        if(TRACK_ALLOCATIONS)
+            target_compile_definitions(${TARGET_NAME} PRIVATE TRACK_ALLOCATIONS)
+        endif()
+
         ###############################################################################
 
         # sanitizers
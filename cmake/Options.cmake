@@ -1,6 +1,8 @@
 option(PROJECT_WARNINGS_AS_ERRORS "Treat warnings as errors" OFF)
 option(USE_ASAN "Use Address Sanitizer" OFF)
 option(USE_MSAN "Use Memory Sanitizer" OFF)
+option(USE_AVX2 "Build the projectile kernels with AVX2 instead of SSE2" OFF)
+option(TRACK_ALLOCATIONS "Replace global operator new/delete with counting versions (--track-allocations, replay budgets)" OFF)
 option(CMAKE_COLOR_DIAGNOSTICS "Enable color diagnostics" ON)
 option(BUILD_SHARED_LIBS "Build SFML as shared library" FALSE)
 
@@ -2,15 +2,40 @@
 #include <iostream>
 #include <stdexcept>
 #include <chrono>
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <optional>
+#include <iterator>
 
 #include "class_headers/World.h"
+#include "class_headers/LevelSpec.h"
 #include "class_headers/Menu.h"
 #include "class_headers/GameExceptions.h"
 #include "class_headers/ConcreteEntityFactory.h"
 #include "class_headers/EntityFactory.h"
 #include "class_headers/SoundManager.h"
-#include "class_headers/Subject.h"
+#include "class_headers/EventBus.h"
+#include "class_headers/StressRunner.h"
+#include "class_headers/NetplayRunner.h"
+#include "class_headers/ReplayRunner.h"
+#include "class_headers/RenderBench.h"
+#include "class_headers/GoldenFrames.h"
+#include "class_headers/InputRecording.h"
+#include "class_headers/PlayerInput.h"
+#include "class_headers/FramePacer.h"
+#include "class_headers/InputSnapshot.h"
+#include "class_headers/FrameRenderer.h"
+#include "class_headers/ParticleSystem.h"
+#include "class_headers/RenderSnapshot.h"
+#include "class_headers/RenderStats.h"
+#include "class_headers/ThreadAffinity.h"
+#include "class_headers/AllocationTracker.h"
+#include "class_headers/SnapshotHistory.h"
+#include "class_headers/HotReloader.h"
+#include "class_headers/StartupTimeline.h"
 
 enum class GameState {
     INTRO_SPLASH,
@@ -38,37 +63,151 @@ sf::Uint8 calculateAlpha(T currentTime, T totalDuration, T fadeInTime, T holdTim
     return static_cast<sf::Uint8>(alphaPercent * 255);
 }
 
-int main() {
-    std::cout << "Game Starting...\n";
-    SoundManager soundManager;
-    sf::RenderWindow window;
+// F5 quick-save, F9 quick-load, R rewinds about three seconds
+void handleSnapshotKey(sf::Keyboard::Key key, World& world, SnapshotHistory& history, std::vector<std::byte>& quickSave) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto elapsedUs = [&start] { return std::chrono::duration<double, std::micro>(Clock::now() - start).count(); };
+    switch (key) {
+        case sf::Keyboard::F5:
+            world.saveSnapshot(quickSave);
+            std::cout << "Quick-save: " << quickSave.size() << " bytes in " << elapsedUs() << " us\n";
+            break;
+        case sf::Keyboard::F9:
+            if (quickSave.empty()) break;
+            world.loadSnapshot(quickSave);
+            history.clear(); // keyframes after the save point belong to another timeline
+            std::cout << "Quick-load: " << quickSave.size() << " bytes in " << elapsedUs() << " us\n";
+            break;
+        case sf::Keyboard::R: {
+            const auto keyframesBack = static_cast<std::size_t>(3.f / history.getInterval());
+            if (history.rewind(world, keyframesBack)) {
+                std::cout << "Rewind restored in " << elapsedUs() << " us\n";
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
 
-    try {
-        constexpr unsigned int windowWidth = 1600, windowHeight = 900;
-        window.create(sf::VideoMode({windowWidth, windowHeight}), "ToonLander", sf::Style::Default);
-        window.setFramerateLimit(90);
+int main(int argc, char* argv[]) {
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    if (std::ranges::find(args, "--stress") != args.end()) { // benchmark mode, no menu or sound
+        return StressRunner::runFromCommandLine(args);
+    }
+    if (std::ranges::find(args, "--netplay") != args.end()) { // rollback co-op against another instance
+        return NetplayRunner::runFromCommandLine(args);
+    }
+    if (std::ranges::find(args, "--replay") != args.end()) { // recorded session at a fixed tick, smoke test
+        return ReplayRunner::runFromCommandLine(args);
+    }
+    if (std::ranges::find(args, "--render-bench") != args.end()) { // off-screen draw throughput per sprite count
+        return RenderBench::runFromCommandLine(args);
+    }
+    if (std::ranges::find(args, "--golden") != args.end()) { // off-screen frames against reference images
+        return GoldenFrames::runFromCommandLine(args);
+    }
+    std::optional<InputRecorder> inputRecorder; // `--record <file>` saves each game's inputs for --replay
+    if (auto recordArg = std::ranges::find(args, "--record"); recordArg != args.end() && std::next(recordArg) != args.end()) {
+        inputRecorder.emplace(*std::next(recordArg));
+    }
+
+    std::cout << "Game Starting...\n";
+    StartupTimeline startup;
+    // independent start-up work runs on its own threads while the window is created; only the font blocks the first
+    // frame (the intro splash is text), the rest is adopted by the frame loop once it is ready
+    auto fontTask = startup.launch("font decode + glyph pages", [] {
+        auto font = std::make_unique<sf::Font>();
+        if (!font->loadFromFile("assets/ARCADECLASSIC.TTF")) {
+            throw ResourceLoadError("Font", "assets/ARCADECLASSIC.TTF", "Failed to load the UI font.");
+        }
+        // glyph pages of every size drawn with it (the texts below and Menu), loaded before the font is shared: baked text
+        // then only looks glyphs up, also for the render stats overlay that is laid out again every frame
+        for (const unsigned int size : {18u, 40u, 48u, 50u, 60u, 80u}) RenderSnapshot::prepareFont(*font, size);
+        return font;
+    });
+    auto soundTask = startup.launch("sound manager (buffers, music streams)", [] { return std::make_unique<SoundManager>(); });
+    auto iconTask = startup.launch("icon decode", [] {
         sf::Image icon;
         if (!icon.loadFromFile("./assets/game_icon.png")) {
             throw ResourceLoadError("Icon", "assets/game_icon.png", "not properly loaded");
         }
-        window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
+        return icon;
+    });
+    auto menuBackgroundTask = startup.launch("menu background decode", [] {
+        sf::Image background;
+        if (!background.loadFromFile(Menu::backgroundPath)) {
+            throw ResourceLoadError("Background", Menu::backgroundPath, "Failed to load background image for menu.");
+        }
+        return background;
+    });
+    std::unique_ptr<SoundManager> soundManager; // silent until soundTask is adopted
+    EventBus eventBus;
+    sf::RenderWindow window;
 
+    try {
+        constexpr unsigned int windowWidth = 1600, windowHeight = 900;
+        {
+            StartupTimeline::Scope windowScope(startup, "window + GL context");
+            window.create(sf::VideoMode({windowWidth, windowHeight}), "ToonLander", sf::Style::Default);
+        }
+        // `--vsync` follows the monitor, `--fps <hz>` paces to a target rate (0 = unlimited), default 90
+        PacingMode pacingMode = PacingMode::TARGET_RATE;
+        float targetFps = 90.f;
+        if (auto fpsArg = std::ranges::find(args, "--fps"); fpsArg != args.end() && std::next(fpsArg) != args.end()) {
+            targetFps = std::stof(*std::next(fpsArg));
+            if (targetFps <= 0.f) pacingMode = PacingMode::UNLIMITED;
+        }
+        const bool vsync = std::ranges::find(args, "--vsync") != args.end();
+        // `--render-thread` draws on its own thread, `--pin-threads` pins simulation and render threads to cores 0 and 1
+        const bool renderThread = std::ranges::find(args, "--render-thread") != args.end();
+        const bool pinThreads = std::ranges::find(args, "--pin-threads") != args.end() && ThreadAffinity::coreCount() > 1;
+        if (vsync) pacingMode = renderThread ? PacingMode::TARGET_RATE : PacingMode::VSYNC; // with a render thread display() blocks there, the simulation keeps its own rate
+        FramePacer framePacer(window, pacingMode, targetFps);
+        if (vsync && renderThread) window.setVerticalSyncEnabled(true);
+        if (pinThreads && !ThreadAffinity::pinCurrentThread(0)) std::cerr << "Simulation thread could not be pinned\n";
+        InputSnapshot inputSnapshot; // keyboard state rebuilt from the event stream each frame
+        SimulationLodConfig lodConfig; // `--no-sim-lod` updates every enemy at full rate
+        lodConfig.enabled = std::ranges::find(args, "--no-sim-lod") == args.end();
+        // `--particle-budget <n>` caps live particles, `[` and `]` halve/double it while playing
+        std::size_t particleBudget = ParticleSystem::defaultBudget;
+        if (auto budgetArg = std::ranges::find(args, "--particle-budget"); budgetArg != args.end() && std::next(budgetArg) != args.end()) {
+            particleBudget = std::stoul(*std::next(budgetArg));
+        }
+        std::optional<ParticleSystem> particles; // built when the first game starts, needs the window's GL context
+        // `--level <file>` plays a level file instead of the built-in layout, `--hot-reload` swaps in changed assets and
+        // level files while the game runs
+        std::string levelPath;
+        if (auto levelArg = std::ranges::find(args, "--level"); levelArg != args.end() && std::next(levelArg) != args.end()) {
+            levelPath = *std::next(levelArg);
+        }
+        LevelSpec currentLevel = levelPath.empty() ? LevelSpec::defaultLevel(window.getSize()) : LevelSpec::loadFromFile(levelPath);
+        std::optional<HotReloader> hotReloader;
+        if (std::ranges::find(args, "--hot-reload") != args.end()) {
+            if (HotReloader::supported()) {
+                hotReloader.emplace(std::vector<std::string>{"assets"}, levelPath);
+            } else {
+                std::cerr << "Hot reload needs inotify (Linux), running without it\n";
+            }
+        }
         GameState currentState = GameState::INTRO_SPLASH;
-        sf::Clock deltaClock; // initiate delta-clock
         sf::Clock introScreenTimer; // timer for intro splash
-        bool gameStartedEventPosted = false; // flag for event management
+        bool introStarted = false; // the splash timer starts with the first frame
 
-        Menu gameMenu(&window);
-        gameMenu.addObserver(&soundManager);
+        std::optional<Menu> gameMenu; // built ahead of the menu once its background is decoded, see menu()
         std::unique_ptr<World> gameWorld = nullptr;
         std::unique_ptr<EntityFactory> entityFactory = std::make_unique<ConcreteEntityFactory>();
+        SnapshotHistory snapshotHistory(10, 0.5f); // last five seconds
+        std::vector<std::byte> quickSave;
 
-        sf::Font introFont;
-        if (!introFont.loadFromFile("assets/ARCADECLASSIC.TTF")) {
-            throw ResourceLoadError("Font", "assets/ARCADECLASSIC.TTF", "Failed to load intro font.");
-        }
-        sf::Text introTextLine1("Coq Studios", introFont, 60);
-        sf::Text introTextLine2("made in SFML", introFont, 40);
+        const std::unique_ptr<sf::Font> loadedFont = [&] {
+            StartupTimeline::Scope waitScope(startup, "wait for font");
+            return fontTask.get();
+        }();
+        const sf::Font& uiFont = *loadedFont; // intro, pause, game over, overlays and menu; loaded once, only used on this thread
+        sf::Text introTextLine1("Coq Studios", uiFont, 60);
+        sf::Text introTextLine2("made in SFML", uiFont, 40);
 
         sf::FloatRect bounds1 = introTextLine1.getLocalBounds();
         introTextLine1.setOrigin(bounds1.left + bounds1.width / 2.f, bounds1.top + bounds1.height / 2.f);
@@ -84,11 +223,7 @@ int main() {
         constexpr float fadeOutStartTime = fadeInDuration + holdDuration;
         constexpr float fadeOutDuration = introDuration - fadeOutStartTime;
 
-        sf::Font pauseFont;
-        if (!pauseFont.loadFromFile("assets/ARCADECLASSIC.TTF")) {
-            throw ResourceLoadError("Font", "assets/ARCADECLASSIC.TTF", "Failed to load pause font.");
-        }
-        sf::Text pauseText("PAUSED", pauseFont, 50);
+        sf::Text pauseText("PAUSED", uiFont, 50);
         pauseText.setFillColor(sf::Color::White);
         sf::FloatRect textBounds = pauseText.getLocalBounds();
         pauseText.setOrigin(textBounds.left + textBounds.width / 2.f, textBounds.top + textBounds.height / 2.f);
@@ -98,12 +233,77 @@ int main() {
         pauseOverlay.setSize(sf::Vector2f(static_cast<float>(windowWidth), static_cast<float>(windowHeight)));
         pauseOverlay.setFillColor(sf::Color(0, 0, 0, 150));
 
+        // built once, constructing them every GAME_OVER frame allocated
+        sf::Text gameOverText("game over", uiFont, 80);
+        sf::FloatRect goBounds = gameOverText.getLocalBounds();
+        gameOverText.setOrigin(goBounds.left + goBounds.width / 2.f, goBounds.top + goBounds.height / 2.f);
+        gameOverText.setPosition(windowWidth / 2.f, windowHeight / 2.f - 60.f);
+        gameOverText.setFillColor(sf::Color::Red);
+
+        sf::Text restartText("press enter to return to menu", uiFont, 40);
+        sf::FloatRect rsBounds = restartText.getLocalBounds();
+        restartText.setOrigin(rsBounds.left + rsBounds.width / 2.f, rsBounds.top + rsBounds.height / 2.f);
+        restartText.setPosition(windowWidth / 2.f, windowHeight / 2.f + 40.f);
+        restartText.setFillColor(sf::Color::White);
+
+        // F3 shows draw calls, vertices, texture switches and state changes of the last presented frame, per layer
+        bool showRenderStats = false;
+        sf::Text renderStatsText("", uiFont, 18);
+        renderStatsText.setPosition(12.f, 8.f);
+        renderStatsText.setFillColor(sf::Color(200, 255, 200));
+
+        // `--track-allocations` counts allocations per frame phase and flags allocation-free phases that allocate
+        const bool trackAllocations = std::ranges::find(args, "--track-allocations") != args.end();
+        if (trackAllocations && !AllocationTracker::isCompiledIn()) {
+            std::cerr << "--track-allocations needs a build configured with -DTRACK_ALLOCATIONS=ON, nothing will be counted" << std::endl;
+        }
+        AllocationTracker::setEnabled(trackAllocations);
+        AllocationFrameLog allocationLog(120); // two seconds of warm-up after start and after every restart
+        std::uint64_t frameNumber = 0;
+
+        auto menu = [&]() -> Menu& { // waits for the background decode only when the menu is needed before it finished
+            if (!gameMenu) {
+                StartupTimeline::Scope menuScope(startup, "menu upload + layout");
+                gameMenu.emplace(&window, uiFont, menuBackgroundTask.get());
+                gameMenu->setEventBus(&eventBus);
+            }
+            return *gameMenu;
+        };
+        bool startupPrinted = false;
+
+        // declared last so it stops before anything a queued frame points to (textures, fonts) is destroyed
+        FrameRenderer frameRenderer(window, &framePacer, renderThread, pinThreads ? 1 : -1);
+
         while (window.isOpen()) {
+            // wait first so events and keyboard state are sampled as late as possible before simulating
+            const float frameDt = framePacer.waitForNextFrame();
+            if (trackAllocations) allocationLog.beginFrame();
+            std::optional<AllocationScope> phase; // tag of the current part of the frame
+            phase.emplace(AllocationTag::INPUT);
+            inputSnapshot.beginTick();
+            if (gameWorld) gameWorld->getFrameArena().reset(); // last frame's scratch is dead by now
+            if (!soundManager && isReady(soundTask)) {
+                soundManager = soundTask.get();
+                eventBus.subscribe(soundManager.get(), EventBus::allEvents, true); // one sound per event type per frame
+                // the music of the current screen, its cue went out before anyone listened
+                if (currentState == GameState::INTRO_SPLASH) eventBus.post(GameEvent::GAME_STARTED);
+                if (currentState == GameState::MENU) eventBus.post(GameEvent::MENU_ENTERED);
+            }
+            if (isReady(iconTask)) {
+                const sf::Image icon = iconTask.get();
+                window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
+            }
+            if (!gameMenu && frameNumber > 0 && isReady(menuBackgroundTask)) menu(); // not before the first frame
             sf::Event event;
             while (window.pollEvent(event)) {
+                inputSnapshot.handleEvent(event);
                 if (event.type == sf::Event::Closed) {
+                    frameRenderer.stop(); // the render thread must let go of the context first
                     window.close();
                 }
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                    showRenderStats = !showRenderStats;
+                }
 
                 // event handling per state
                 switch (currentState) {
@@ -111,52 +311,62 @@ int main() {
                         if (event.type == sf::Event::KeyPressed &&
    (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Space || event.key.code == sf::Keyboard::Escape) ) {
                             // skip intro logic: directly transition
-                            soundManager.stopIntroTheme(); // stop intro if playing
+                            if (soundManager) soundManager->stopIntroTheme(); // stop intro if playing
                             currentState = GameState::MENU;
-                            soundManager.onNotify(GameEvent::MENU_ENTERED); // tell soundmanager menu has started
+                            eventBus.post(GameEvent::MENU_ENTERED); // tell soundmanager menu has started
                             std::cout << "intro skipped, transitioning to menu state\n";
    }
                         break;
                     case GameState::MENU:
-                        gameMenu.handleInput(event);
+                        menu().handleInput(event);
                         break;
                     case GameState::PLAYING:
                         if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
                             currentState = GameState::PAUSED;
                             std::cout << "Game Paused!\n";
+                        } else if (event.type == sf::Event::KeyPressed &&
+                                   (event.key.code == sf::Keyboard::LBracket || event.key.code == sf::Keyboard::RBracket)) {
+                            const std::size_t budget = particles->getBudget();
+                            particles->setBudget(event.key.code == sf::Keyboard::LBracket ? budget / 2 : std::max<std::size_t>(budget * 2, 1024));
+                            std::cout << "Particle budget: " << particles->getBudget() << "\n";
+                        } else if (event.type == sf::Event::KeyPressed && gameWorld) {
+                            handleSnapshotKey(event.key.code, *gameWorld, snapshotHistory, quickSave);
                         }
                         break;
                     case GameState::PAUSED:
                         if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
-                            currentState = GameState::PLAYING;
-                            deltaClock.restart();
+                            currentState = GameState::PLAYING; // frameDt is a single frame, the pause is not simulated
                             std::cout << "Game Resumed\n";
                         }
                         break;
                     case GameState::GAME_OVER:
                         if (event.type == sf::Event::KeyPressed &&
                             (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Escape)) {
-                            currentState = GameState::MENU;
-                            gameWorld.reset();
-                            if (!entityFactory) {
-                                entityFactory = std::make_unique<ConcreteEntityFactory>();
-                            }
+                            currentState = GameState::MENU; // the world is kept and reset on the next start
                         }
                         break;
                 }
             }
 
-            float dt = 0.0f; // calculate delta time
-            if (currentState != GameState::PAUSED) {
-                dt = deltaClock.restart().asSeconds();
+            if (hotReloader && hotReloader->hasPending()) { // frame boundary: nothing is simulated or drawn right now
+                const auto renderingPaused = frameRenderer.pauseRendering();
+                // netplay runs its own loop without hot reload, so rewinds and quick-saves are the only snapshots to drop
+                if (hotReloader->applyPending(gameWorld.get(), soundManager.get(), currentLevel) &&
+                    (snapshotHistory.size() > 0 || !quickSave.empty())) {
+                    snapshotHistory.clear();
+                    quickSave.clear();
+                    std::cout << "Hot reload: level layout changed, rewind history and quick-save dropped (taken on the old platforms)\n";
+                }
             }
 
+            const float dt = currentState != GameState::PAUSED ? frameDt : 0.f;
+
+            phase.emplace(AllocationTag::SIMULATION);
             switch (currentState) { // update logic per state
                 case GameState::INTRO_SPLASH:
                 {
-                    if (!gameStartedEventPosted) {
-                        soundManager.onNotify(GameEvent::GAME_STARTED); // Trigger intro sound
-                        gameStartedEventPosted = true;
+                    if (!introStarted) { // the intro sound is cued when the sound manager is adopted
+                        introStarted = true;
                         introScreenTimer.restart();
                     }
 
@@ -167,30 +377,54 @@ int main() {
                     introTextLine2.setFillColor(sf::Color(255, 255, 255, alpha));
 
                     if (introTimeElapsed >= introDuration) {
-                        soundManager.stopIntroTheme(); // Ensure intro theme is stopped
+                        if (soundManager) soundManager->stopIntroTheme(); // Ensure intro theme is stopped
                         currentState = GameState::MENU;
-                        soundManager.onNotify(GameEvent::MENU_ENTERED); // Trigger menu music
+                        eventBus.post(GameEvent::MENU_ENTERED); // Trigger menu music
                         std::cout << "intro finished, transitioning to menu state\n";
                     }
                 }
                 break;
                 case GameState::MENU:
-                    gameMenu.update(dt);
-                    if (gameMenu.isStartRequested()) {
-                        if (!entityFactory) {
-                             entityFactory = std::make_unique<ConcreteEntityFactory>();
+                {
+                    AllocationScope uiScope(AllocationTag::UI);
+                    menu().update(dt);
+                }
+                    if (gameMenu->isStartRequested()) {
+                        gameMenu->clearStartRequest();
+                        if (gameWorld) { // restart in place, textures, font and pools are already warm
+                            gameWorld->reset(currentLevel);
+                        } else {
+                            gameWorld = std::make_unique<World>(&window, std::move(entityFactory), &eventBus);
+                            gameWorld->setSimulationLod(lodConfig);
+                            if (!levelPath.empty()) gameWorld->reset(currentLevel); // built with the default layout
                         }
-                        gameWorld = std::make_unique<World>(&window, std::move(entityFactory), &soundManager);
-                        soundManager.onNotify(GameEvent::GAMEPLAY_STARTED);
+                        framePacer.restartDelta(); // world creation time is not simulated
+                        snapshotHistory.clear();
+                        if (particles) {
+                            particles->clear();
+                        } else {
+                            particles.emplace(&eventBus, ParticleSystem::defaultCapacity, particleBudget);
+                        }
+                        if (inputRecorder) inputRecorder->restart();
+                        eventBus.post(GameEvent::GAMEPLAY_STARTED);
+                        allocationLog.restartWarmup();
                         currentState = GameState::PLAYING;
                     }
                     break;
                 case GameState::PLAYING:
                     if (gameWorld) {
-                        gameWorld->handleInput();
+                        const PlayerInput input = PlayerInput::fromSnapshot(inputSnapshot);
+                        gameWorld->handleInput(input, {});
+                        if (inputRecorder) inputRecorder->update(dt, input);
                         gameWorld->update(dt);
+                        snapshotHistory.update(dt, *gameWorld);
                         if (gameWorld->isGameOver()) {
                             std::cout << "Game Over!\n";
+                            gameWorld->getWorldArena().printSummary();
+                            const NavGraphStats& nav = gameWorld->getNavGraphStats();
+                            std::cout << "Navigation: " << nav.spans << " spans, " << nav.links << " links, "
+                                      << nav.searches << " searches, " << nav.cacheHits << " cache hits\n";
+                            if (inputRecorder) inputRecorder->save();
                             currentState = GameState::GAME_OVER;
                         }
                     } else {
@@ -202,41 +436,77 @@ int main() {
                     break;
             }
 
-            window.clear();
+            phase.emplace(AllocationTag::EVENTS);
+            eventBus.dispatch(); // deliver this frame's events in one batch, after every update
+            if (particles) particles->update(dt); // emitted by the dispatch above, frozen while paused
+
+            phase.emplace(AllocationTag::UI); // overlays; the world and the renderer tag their own parts
+            RenderSnapshot& frame = frameRenderer.beginFrame(); // drawn inline or by the render thread
+            frame.setLayer(RenderLayer::UI); // the world, menu and particles tag their own items
             switch (currentState) {
                 case GameState::INTRO_SPLASH:
-                    window.draw(introTextLine1);
-                    window.draw(introTextLine2);
+                    frame.addText(introTextLine1);
+                    frame.addText(introTextLine2);
                     break;
                 case GameState::MENU:
-                    gameMenu.draw();
+                    menu().appendRenderItems(frame);
                     break;
                 case GameState::PLAYING:
-                    if (gameWorld) gameWorld->draw();
+                    if (gameWorld) gameWorld->buildRenderSnapshot(frame);
+                    particles->appendRenderItems(frame);
                     break;
                 case GameState::PAUSED:
-                    if (gameWorld) gameWorld->draw();
-                    window.draw(pauseOverlay);
-                    window.draw(pauseText);
+                    if (gameWorld) gameWorld->buildRenderSnapshot(frame);
+                    particles->appendRenderItems(frame);
+                    frame.setLayer(RenderLayer::UI);
+                    frame.addRectangle(pauseOverlay);
+                    frame.addText(pauseText);
                     break;
                 case GameState::GAME_OVER:
-                    if (gameWorld) gameWorld->draw();
-                    sf::Text gameOverText("game over", introFont, 80);
-                    sf::FloatRect goBounds = gameOverText.getLocalBounds();
-                    gameOverText.setOrigin(goBounds.left + goBounds.width / 2.f, goBounds.top + goBounds.height / 2.f);
-                    gameOverText.setPosition(windowWidth / 2.f, windowHeight / 2.f - 60.f);
-                    gameOverText.setFillColor(sf::Color::Red);
-                    window.draw(gameOverText);
-
-                    sf::Text restartText("press enter to return to menu", introFont, 40);
-                    sf::FloatRect rsBounds = restartText.getLocalBounds();
-                    restartText.setOrigin(rsBounds.left + rsBounds.width / 2.f, rsBounds.top + rsBounds.height / 2.f);
-                    restartText.setPosition(windowWidth / 2.f, windowHeight / 2.f + 40.f);
-                    restartText.setFillColor(sf::Color::White);
-                    window.draw(restartText);
+                    if (gameWorld) gameWorld->buildRenderSnapshot(frame);
+                    particles->appendRenderItems(frame);
+                    frame.setLayer(RenderLayer::UI);
+                    frame.addText(gameOverText);
+                    frame.addText(restartText);
                     break;
             }
-            window.display();
+            if (showRenderStats) { // one frame behind with a render thread, the counts come from the last present
+                frame.setLayer(RenderLayer::UI);
+                renderStatsText.setString(frameRenderer.getLastFrameStats().format());
+                const sf::FloatRect statsBounds = renderStatsText.getGlobalBounds();
+                frame.addRectangle({statsBounds.left - 6.f, statsBounds.top - 6.f, statsBounds.width + 12.f, statsBounds.height + 12.f},
+                                   sf::Color(0, 0, 0, 170), sf::Color::Transparent, 0.f);
+                frame.addText(renderStatsText);
+            }
+            frameRenderer.submit();
+            if (frameNumber == 0) startup.mark("first frame submitted");
+            if (!startupPrinted && frameNumber > 0 && soundManager && gameMenu && !iconTask.valid()) {
+                startup.print(std::cout); // everything the start-up launched has been adopted
+                startupPrinted = true;
+            }
+            phase.reset();
+            if (trackAllocations) allocationLog.endFrame(frameNumber);
+            ++frameNumber;
+        }
+        frameRenderer.stop();
+        if (frameRenderer.getPublishedFrames() > frameRenderer.getRenderedFrames()) {
+            std::cout << "Render thread skipped " << frameRenderer.getPublishedFrames() - frameRenderer.getRenderedFrames()
+                      << " of " << frameRenderer.getPublishedFrames() << " frames\n";
+        }
+        const PacingStats pacing = framePacer.getStats();
+        std::cout << "Frame pacing: " << pacing.meanIntervalMs << " ms mean present interval, " << pacing.stdDevMs
+                  << " ms jitter (std dev), " << pacing.p99DeviationMs << " ms p99 deviation, " << pacing.maxIntervalMs
+                  << " ms worst, spin margin " << pacing.spinMarginMs << " ms\n";
+        if (frameRenderer.getRenderedFrames() > 0) {
+            std::cout << "Render counters, mean per frame:\n"
+                      << frameRenderer.getTotalStats().format(static_cast<double>(frameRenderer.getRenderedFrames()));
+        }
+        if (trackAllocations) {
+            allocationLog.printSummary();
+            if (gameWorld) gameWorld->getFrameArena().printSummary();
+        }
+        if (inputRecorder && (currentState == GameState::PLAYING || currentState == GameState::PAUSED)) {
+            inputRecorder->save(); // closed mid-game
         }
     } catch (const ResourceLoadError& e) {
         std::cerr << "\n--- RESOURCE ERROR CAUGHT ---\n" << e.what() << std::endl;
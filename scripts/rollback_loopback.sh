@@ -0,0 +1,23 @@
+#!/usr/bin/bash
+
+# two bot instances on loopback over a simulated bad connection, fails on a desync
+EXECUTABLE=${EXECUTABLE:-./oop}
+TICKS=${TICKS:-3600}
+LATENCY=${LATENCY:-60}
+JITTER=${JITTER:-20}
+LOSS=${LOSS:-0.05}
+
+common=(--netplay --bot --headless --ticks "${TICKS}" --latency "${LATENCY}" --jitter "${JITTER}" --loss "${LOSS}")
+
+"${EXECUTABLE}" "${common[@]}" --slot 0 --port 7000 --peer 127.0.0.1:7001 > rollback_slot0.log 2>&1 &
+first=$!
+"${EXECUTABLE}" "${common[@]}" --slot 1 --port 7001 --peer 127.0.0.1:7000 > rollback_slot1.log 2>&1
+second_status=$?
+wait "${first}"
+first_status=$?
+
+cat rollback_slot0.log rollback_slot1.log
+if [[ ${first_status} -ne 0 || ${second_status} -ne 0 ]]; then
+    echo "rollback loopback failed (exit codes ${first_status} / ${second_status})"
+    exit 1
+fi
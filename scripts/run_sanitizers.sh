@@ -1,8 +1,8 @@
 #!/usr/bin/bash
 
-INPUT_FILENAME=${INPUT_FILENAME:-tastatura.txt}
 ZIP_NAME=${ZIP_NAME:-install_dir/bin}
 EXECUTABLE_NAME=${EXECUTABLE_NAME:-oop}
+REPLAY=${REPLAY:-assets/replays/smoke.txt}
 
-tr -d '\r' < "${INPUT_FILENAME}" | ./"${ZIP_NAME}"/"${EXECUTABLE_NAME}" &
-bash ./scripts/run_test.sh 3 1 2
+# no budget here, instrumented builds are several times slower
+./"${ZIP_NAME}"/"${EXECUTABLE_NAME}" --replay "${REPLAY}" --headless
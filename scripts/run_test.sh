@@ -1,13 +1,9 @@
 #!/usr/bin/bash
 
-startup_sleep=$1
-command_sleep=$2
-exit_sleep=$3
+# replays a recorded session at a fixed tick and fails when it exceeds the checked-in budget
+ZIP_NAME=${ZIP_NAME:-install_dir/bin}
+EXECUTABLE_NAME=${EXECUTABLE_NAME:-oop}
+REPLAY=${REPLAY:-assets/replays/smoke.txt}
+BUDGET=${BUDGET:-assets/replays/smoke_budget.txt}
 
-APP_WINDOW=${APP_WINDOW:-"My Window"}
-
-sleep "${startup_sleep}" && xdotool search --name "${APP_WINDOW}" key X &&
-sleep "${command_sleep}" && xdotool search --name "${APP_WINDOW}" key Y &&
-sleep "${command_sleep}" && xdotool search --name "${APP_WINDOW}" key X &&
-sleep "${command_sleep}" && xdotool search --name "${APP_WINDOW}" key Z &&
-sleep "${exit_sleep}" && xdotool search --name "${APP_WINDOW}" key Alt+F4
+./"${ZIP_NAME}"/"${EXECUTABLE_NAME}" --replay "${REPLAY}" --budget "${BUDGET}" --headless "$@"
@@ -0,0 +1,128 @@
+// checks the vector projectile kernels of this build (SSE2, or AVX2 with -mavx2) against the scalar reference
+// on random bullets, for every count up to a few vector widths so the scalar tails are covered too
+#include "../class_headers/ProjectileKernels.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int skipped{77}; // SKIP_RETURN_CODE in CMakeLists.txt
+
+    struct Bullets {
+        std::vector<float> x, y, vx, vy, halfWidth, halfHeight;
+
+        Bullets(std::size_t count, std::mt19937& rng) :
+            x(count), y(count), vx(count), vy(count), halfWidth(count), halfHeight(count) {
+            std::uniform_real_distribution<float> position(-200.f, 2100.f);
+            std::uniform_real_distribution<float> velocity(-60.f, 60.f);
+            std::uniform_real_distribution<float> extent(1.f, 40.f);
+            std::uniform_int_distribution<int> special(0, 7);
+            for (std::size_t i = 0; i < count; ++i) {
+                x[i] = position(rng);
+                y[i] = position(rng) * 0.5f;
+                vx[i] = velocity(rng);
+                vy[i] = velocity(rng);
+                halfWidth[i] = extent(rng);
+                halfHeight[i] = extent(rng);
+                switch (special(rng)) { // the parallel and edge cases the blends have to get right
+                    case 0: vx[i] = 0.f; break;
+                    case 1: vy[i] = 0.f; break;
+                    case 2: vx[i] = vy[i] = 0.f; break;
+                    default: break;
+                }
+            }
+        }
+    };
+
+    int failures{0};
+
+    template <typename T>
+    void expectEqual(const char* kernel, std::size_t count, const std::vector<T>& expected, const std::vector<T>& actual) {
+        if (std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(T)) == 0) return; // bit-identical
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            if (std::memcmp(&expected[i], &actual[i], sizeof(T)) != 0) {
+                std::cerr << "FAIL " << kernel << " count " << count << " index " << i << ": scalar "
+                          << +expected[i] << ", " << ProjectileKernels::instructionSet() << " " << +actual[i] << "\n";
+                break;
+            }
+        }
+        ++failures;
+    }
+
+    void checkCount(std::size_t count, std::mt19937& rng) {
+        const Bullets bullets(count, rng);
+        std::uniform_real_distribution<float> position(0.f, 1800.f);
+        std::uniform_real_distribution<float> extent(0.f, 300.f);
+        const sf::FloatRect target(position(rng), position(rng) * 0.5f, extent(rng), extent(rng));
+
+        std::vector<float> scalarX = bullets.x, scalarY = bullets.y, vectorX = bullets.x, vectorY = bullets.y;
+        ProjectileKernels::integrateScalar(scalarX.data(), scalarY.data(), bullets.vx.data(), bullets.vy.data(), count);
+        ProjectileKernels::integrate(vectorX.data(), vectorY.data(), bullets.vx.data(), bullets.vy.data(), count);
+        expectEqual("integrate x", count, scalarX, vectorX);
+        expectEqual("integrate y", count, scalarY, vectorY);
+
+        std::vector<std::uint8_t> expected(count, 2), actual(count, 2);
+        ProjectileKernels::flagOutOfBoundsScalar(bullets.x.data(), bullets.y.data(), bullets.halfWidth.data(), bullets.halfHeight.data(),
+                                                 count, 1920.f, 1080.f, expected.data());
+        ProjectileKernels::flagOutOfBounds(bullets.x.data(), bullets.y.data(), bullets.halfWidth.data(), bullets.halfHeight.data(),
+                                           count, 1920.f, 1080.f, actual.data());
+        expectEqual("flagOutOfBounds", count, expected, actual);
+
+        ProjectileKernels::overlapTargetScalar(bullets.x.data(), bullets.y.data(), bullets.halfWidth.data(), bullets.halfHeight.data(),
+                                               count, target, expected.data());
+        ProjectileKernels::overlapTarget(bullets.x.data(), bullets.y.data(), bullets.halfWidth.data(), bullets.halfHeight.data(),
+                                         count, target, actual.data());
+        expectEqual("overlapTarget", count, expected, actual);
+
+        std::vector<float> expectedTimes(count, -1.f), actualTimes(count, -1.f);
+        ProjectileKernels::sweepTargetScalar(bullets.x.data(), bullets.y.data(), bullets.vx.data(), bullets.vy.data(),
+                                             bullets.halfWidth.data(), bullets.halfHeight.data(), count, target, expectedTimes.data());
+        ProjectileKernels::sweepTarget(bullets.x.data(), bullets.y.data(), bullets.vx.data(), bullets.vy.data(),
+                                       bullets.halfWidth.data(), bullets.halfHeight.data(), count, target, actualTimes.data());
+        expectEqual("sweepTarget", count, expectedTimes, actualTimes);
+    }
+
+    // one bullet per lane crossing a 10 px target at a known point of its step, same answer on every path
+    void checkTimeOfImpact() {
+        constexpr std::size_t count{9}; // a full AVX2 vector plus a scalar tail
+        const sf::FloatRect target(100.f, 0.f, 10.f, 10.f);
+        std::vector<float> x(count), y(count, 5.f), vx(count, 40.f), vy(count, 0.f), half(count, 1.f), times(count);
+        for (std::size_t i = 0; i < count; ++i) x[i] = 109.f + 4.f * static_cast<float>(i); // steps start at 69..101
+        ProjectileKernels::sweepTarget(x.data(), y.data(), vx.data(), vy.data(), half.data(), half.data(), count, target, times.data());
+        for (std::size_t i = 0; i < count; ++i) {
+            const float start = x[i] - vx[i];
+            const float expected = start > 99.f ? 0.f : (99.f - start) / 40.f; // the grown target spans 99..111
+            if (times[i] != expected) {
+                std::cerr << "FAIL sweepTarget time of impact, lane " << i << ": expected " << expected << ", got " << times[i] << "\n";
+                ++failures;
+            }
+        }
+    }
+}
+
+int main() {
+    const std::string instructionSet = ProjectileKernels::instructionSet();
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+    if (!__builtin_cpu_supports("avx2")) {
+        std::cout << "AVX2 kernels built, but this CPU has no AVX2, skipped\n";
+        return skipped;
+    }
+#endif
+    if (instructionSet == "scalar") {
+        std::cout << "no vector kernels on this target, nothing to compare\n";
+        return skipped;
+    }
+
+    std::mt19937 rng(20240521); // fixed, a failure reproduces
+    for (int round = 0; round < 50; ++round) {
+        for (std::size_t count = 0; count <= 33; ++count) checkCount(count, rng); // every tail length of 4 and 8 lanes
+        checkCount(1000, rng);
+        checkCount(1027, rng);
+    }
+    checkTimeOfImpact();
+    std::cout << instructionSet << " projectile kernels: " << (failures == 0 ? "match" : "DIFFER FROM") << " the scalar path\n";
+    return failures == 0 ? 0 : 1;
+}